@@ -0,0 +1,64 @@
+/*
+ * alarm.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_ALARM_H_
+#define INC_ALARM_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+#include "epoch.h"
+
+/* Private define */
+#define ALARM_MAX			8 // fired alarms are reported as a bit mask of slots, keep <= 8
+#define ALARM_NONE			0xff
+#define ALARM_NEVER			((Epoch)-1)
+
+#define ALARM_WEEKDAYS		0x3e // Monday to Friday, bit 0 = Sunday ... bit 6 = Saturday
+#define ALARM_EVERY_DAY		0x7f
+
+typedef enum Alarm_Repeat
+{
+	ALARM_ONCE,
+	ALARM_DAILY,
+	ALARM_WEEKLY,
+	ALARM_MONTHLY
+}Alarm_Repeat;
+
+typedef struct
+{
+	Alarm_Repeat repeat;
+	uint8_t hour;
+	uint8_t minute;
+	uint8_t second;
+	uint8_t weekdays;	// ALARM_WEEKLY: bit (day - 1) set for every day of week the alarm rings
+	uint8_t date;		// ALARM_MONTHLY: day of month, months without this date are skipped
+	Epoch once;			// ALARM_ONCE: absolute time, 0 = next occurrence of hour:minute:second
+
+	Epoch next_fire;
+}Alarm;
+
+/* Variables */
+extern Alarm alarm_table[ALARM_MAX];
+
+/* Functions */
+void initAlarm(void);
+
+uint8_t alarmAdd(const Alarm *pAlarm, Epoch now);
+bool alarmRemove(uint8_t slot);
+void alarmClear(void);
+
+uint8_t alarmProcess(Epoch now);
+void alarmReschedule(Epoch now);
+
+Epoch alarmNextFire(const Alarm *pAlarm, Epoch after);
+uint8_t alarmGetNext(void);
+uint8_t alarmCount(void);
+
+void alarmReport(void);
+
+#endif /* INC_ALARM_H_ */
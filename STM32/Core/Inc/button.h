@@ -9,14 +9,50 @@
 #define INC_BUTTON_H_
 
 #include <stdint.h>
-#include "spi.h"
-#include "gpio.h"
+#include "dataStructure.h"
 
-/* Variables */
-extern uint16_t button_count[16];
+/* Private define */
+#define BUTTON_COUNT			16
+#define BUTTON_SCAN_MS			10	// period buttonScan is called with, debounce takes 4 scans
+#define BUTTON_QUEUE_SIZE		16	// must be a power of two
+#define BUTTON_QUEUE_MASK		(BUTTON_QUEUE_SIZE - 1)
+
+typedef enum Button_Event_Type
+{
+	BUTTON_EVENT_NONE,
+	BUTTON_PRESS,			// 4 scans down
+	BUTTON_RELEASE,			// 4 scans up
+	BUTTON_LONG,			// held for long_ms, once per press
+	BUTTON_REPEAT,			// held, sent every repeat interval after repeat_delay_ms
+	BUTTON_EVENT_TYPE_COUNT
+}Button_Event_Type;
+
+typedef struct
+{
+	uint8_t key;
+	Button_Event_Type type;
+	uint32_t timestamp;		// sTimer tick of the scan that produced the event
+	uint32_t time_us;		// timebase us of that scan, where the input latency is measured from
+}Button_Event;
+
+/* all times are counted from the debounced press and rounded up to BUTTON_SCAN_MS */
+typedef struct
+{
+	uint16_t long_ms;			// 0: no long press event
+	uint16_t repeat_delay_ms;	// first repeat after the press, 0: no repeat
+	uint16_t repeat_period_ms;	// interval of the first repeats
+	uint16_t repeat_min_ms;		// every repeat shortens the interval by a quarter down to this
+}Button_Config;
 
 /* Functions */
 void initButton(void);
 void buttonScan(void);
 
+void buttonConfigure(uint8_t key, const Button_Config *pConfig);
+bool buttonGetEvent(Button_Event *pEvent);
+bool buttonPending(void);
+
+bool buttonInject(uint8_t key, Button_Event_Type type);
+void buttonReport(void);
+
 #endif /* INC_BUTTON_H_ */
@@ -0,0 +1,57 @@
+/*
+ * deadline.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_DEADLINE_H_
+#define INC_DEADLINE_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+/* jitter histogram: bucket 0 < 16us, bucket n < 16us << n, last bucket collects the rest */
+#define DEADLINE_HISTOGRAM_SIZE		12
+#define DEADLINE_HISTOGRAM_SHIFT	4
+
+/* X(id, name, period us, tolerance us): an activation later than period + tolerance is a deadline miss */
+#define DEADLINE_JOBS(X) \
+	X(DEADLINE_TICK,		"tick isr",		1000,	100) \
+	X(DEADLINE_EVENT,		"event",		1000,	1000) \
+	X(DEADLINE_INPUT,		"button scan",	10000,	5000) \
+	X(DEADLINE_TEMP,		"temperature",	50000,	50000) \
+	X(DEADLINE_CLOCK,		"clock 500ms",	500000,	50000)
+
+typedef enum Deadline_Job
+{
+#define DEADLINE_JOB_ID(id, name, period, tolerance) id,
+	DEADLINE_JOBS(DEADLINE_JOB_ID)
+#undef DEADLINE_JOB_ID
+	DEADLINE_JOB_COUNT
+}Deadline_Job;
+
+typedef struct
+{
+	uint32_t last;			// timestamp of the previous activation, us
+	uint32_t count;
+	uint32_t misses;
+	int32_t min_jitter;		// us, activation interval minus period
+	int32_t max_jitter;
+	uint32_t histogram[DEADLINE_HISTOGRAM_SIZE];	// absolute jitter
+}Deadline_Stats;
+
+/* Variables */
+extern Deadline_Stats deadline_stats[DEADLINE_JOB_COUNT];
+
+/* Functions */
+void initDeadline(void);
+
+void deadlineMark(Deadline_Job job);
+void deadlineReset(void);
+
+void deadlineReport(void);
+
+#endif /* INC_DEADLINE_H_ */
@@ -54,6 +54,13 @@
 #define TEMP_MSB			0x11
 #define TEMP_LSB			0x12
 
+#define DS3231_REG_COUNT	0x13 /* register 0x00 to 0x12 */
+#define DS3231_POLL_COUNT	0x10 /* register 0x00 to 0x0f: time, alarms, control and status */
+
+/* events returned by ds3231Poll */
+#define DS3231_EVENT_A1		(1 << DS3231_A1F)
+#define DS3231_EVENT_A2		(1 << DS3231_A2F)
+
 /* Variables */
 extern uint8_t ds3231_hours;
 extern uint8_t ds3231_min;
@@ -63,6 +70,8 @@ extern uint8_t ds3231_day;
 extern uint8_t ds3231_month;
 extern uint8_t ds3231_year;
 
+extern uint8_t ds3231_registers[DS3231_REG_COUNT];
+
 /*----------------------------------------------------------------------------*/
 
 typedef struct
@@ -125,12 +134,18 @@ typedef enum DS3231_InterruptMode
 }DS3231_InterruptMode;
 
 /* Functions */
-void initds3231(void);
+bool initds3231(void);
 
 uint8_t ds3231Read(uint8_t address);
 
 void ds3231ReadTime(void);
+uint8_t ds3231Poll(void);
 float ds3231ReadTemp(void);
+bool ds3231ReadAllRegisters(void);
+bool ds3231ReadBurst(uint8_t address, uint8_t *data, uint8_t size);
+
+bool ds3231StartConversion(void);
+int16_t ds3231DecodeTemp(uint8_t msb_reg, uint8_t lsb_reg);
 
 void ds3231SetSec(uint8_t second);
 void ds3231SetMin(uint8_t minute);
@@ -0,0 +1,55 @@
+/*
+ * ds3231Sim.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_DS3231SIM_H_
+#define INC_DS3231SIM_H_
+
+/*
+ * Register level model of ds3231, it does not use HAL so it also builds on a host.
+ * Define DS3231_SIM to route i2cBus transactions to the model instead of I2C1,
+ * a host build can call ds3231SimMemRead()/ds3231SimMemWrite()/ds3231SimIsDeviceReady()
+ * from its HAL_I2C_Mem_Read()/HAL_I2C_Mem_Write()/HAL_I2C_IsDeviceReady() mocks.
+ */
+
+/* Includes */
+#include <stdint.h>
+#include "ds3231.h"
+
+/* Private define */
+#define DS3231_SIM_ADDRESS		(0x68 << 1)
+#define DS3231_SIM_CONV_MS		200 // duration of a temperature conversion
+#define DS3231_SIM_TEMP_DEFAULT	100 // 25.00 C in quarter degree
+
+typedef struct
+{
+	uint32_t reads;
+	uint32_t writes;
+	uint32_t probes;	// IsDeviceReady calls
+	uint32_t bytes;
+	uint32_t nacks;		// transactions to a wrong address
+}DS3231_Sim_Stats;
+
+/* Variables */
+extern uint8_t ds3231_sim_registers[DS3231_REG_COUNT];
+extern DS3231_Sim_Stats ds3231_sim_stats;
+
+/* Functions */
+void initDS3231Sim(void);
+
+void ds3231SimSetSpeed(uint32_t factor);
+void ds3231SimAdvance(uint32_t elapsed_ms);
+void ds3231SimTickSecond(void);
+void ds3231SimSetTemp(int16_t quarter_degree);
+
+bool ds3231SimMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+bool ds3231SimMemWrite(uint16_t dev_address, uint16_t mem_address, const uint8_t *data, uint16_t size);
+bool ds3231SimIsDeviceReady(uint16_t dev_address);
+
+uint32_t ds3231SimGetTransactions(void);
+void ds3231SimResetStats(void);
+
+#endif /* INC_DS3231SIM_H_ */
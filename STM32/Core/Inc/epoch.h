@@ -0,0 +1,43 @@
+/*
+ * epoch.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_EPOCH_H_
+#define INC_EPOCH_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+#include "ds3231.h"
+
+/* Private define */
+#define EPOCH_SECONDS_PER_MINUTE	60
+#define EPOCH_SECONDS_PER_HOUR		3600
+#define EPOCH_SECONDS_PER_DAY		86400
+
+/* range the ds3231 calendar agrees with the gregorian rule: 2000-01-01 00:00:00 to 2099-12-31 23:59:59.
+ * the century bit reaches 2199 but the ds3231 counts 29 Feb 2100, which does not exist */
+#define EPOCH_MIN					((Epoch)946684800)
+#define EPOCH_MAX					((Epoch)4102444799)
+
+/* seconds since 1970-01-01 00:00:00, date comparisons and durations are plain subtractions */
+typedef int64_t Epoch;
+
+/* Functions */
+int32_t epochDaysFromCivil(int32_t year, uint8_t month, uint8_t date);
+void epochCivilFromDays(int32_t days, uint16_t *year, uint8_t *month, uint8_t *date);
+uint8_t epochWeekday(int32_t days);
+
+bool epochIsLeapYear(uint16_t year);
+uint8_t epochDaysInMonth(uint8_t month, uint16_t year);
+
+Epoch epochFromTime(const Time *pTime);
+void epochToTime(Epoch epoch, Time *pTime);
+
+Epoch epochAddMonths(Epoch epoch, int32_t months);
+Epoch epochClamp(Epoch epoch);
+
+#endif /* INC_EPOCH_H_ */
@@ -0,0 +1,66 @@
+/*
+ * event.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_EVENT_H_
+#define INC_EVENT_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define EVENT_QUEUE_SIZE		16 // must be a power of two
+#define EVENT_QUEUE_MASK		(EVENT_QUEUE_SIZE - 1)
+
+/* every interrupt source owns one queue: single producer (its ISR), single consumer (main loop) */
+typedef enum Event_Source
+{
+	EVENT_SOURCE_TIMER,
+	EVENT_SOURCE_UART,
+	EVENT_SOURCE_COUNT
+}Event_Source;
+
+typedef enum Event_Type
+{
+	EVENT_NONE,
+	EVENT_TICK_50MS,
+	EVENT_TICK_500MS,
+	EVENT_UART_RX			// data: received byte
+}Event_Type;
+
+typedef struct
+{
+	Event_Type type;
+	uint32_t data;
+	uint32_t timestamp;		// sTimer tick when posted, orders events across sources
+}Event;
+
+typedef struct
+{
+	Event buffer[EVENT_QUEUE_SIZE];
+	volatile uint16_t head;	// written by producer only
+	volatile uint16_t tail;	// written by consumer only
+
+	uint16_t high_water;	// most events waiting at once
+	uint32_t posted;
+	uint32_t drops;			// events lost because the queue was full
+}Event_Queue;
+
+/* Variables */
+extern Event_Queue event_queues[EVENT_SOURCE_COUNT];
+
+/* Functions */
+void initEvent(void);
+
+bool eventPost(Event_Source source, Event_Type type, uint32_t data);
+void eventPostTimer(void *context);
+bool eventGet(Event *pEvent);
+bool eventPending(void);
+
+void eventReport(void);
+
+#endif /* INC_EVENT_H_ */
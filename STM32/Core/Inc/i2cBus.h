@@ -0,0 +1,56 @@
+/*
+ * i2cBus.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_I2CBUS_H_
+#define INC_I2CBUS_H_
+
+/* Includes */
+#include <stdint.h>
+#include "i2c.h"
+#include "dataStructure.h"
+
+/* Private define */
+#define I2C_BUS_TIMEOUT			10 // ms, HAL timeout of each transaction
+#define I2C_BUS_MAX_RETRIES		3  // retries of a failed transaction, bus is recovered before each retry
+#define I2C_BUS_RECOVERY_CLOCKS	9  // SCL pulses to release a slave holding SDA low
+#define I2C_BUS_HALF_PERIOD_US	5  // SCL half period during recovery (100kHz)
+
+/* latency histogram: bucket 0 < 64us, bucket n < 64us << n, last bucket collects the rest */
+#define I2C_BUS_HISTOGRAM_SIZE	8
+#define I2C_BUS_HISTOGRAM_SHIFT	6
+
+#define I2C_BUS_SCL_Pin			GPIO_PIN_6
+#define I2C_BUS_SDA_Pin			GPIO_PIN_7
+#define I2C_BUS_GPIO_Port		GPIOB
+
+typedef struct
+{
+	uint32_t transactions;
+	uint32_t errors;	// failed attempts
+	uint32_t nacks;
+	uint32_t timeouts;
+	uint32_t busy;
+	uint32_t retries;
+	uint32_t recoveries;
+	uint32_t max_us;
+	uint32_t histogram[I2C_BUS_HISTOGRAM_SIZE];
+}I2C_Bus_Stats;
+
+/* Variables */
+extern I2C_Bus_Stats i2c_bus_stats;
+
+/* Functions */
+void initI2CBus(void);
+
+bool i2cBusIsDeviceReady(uint16_t dev_address);
+HAL_StatusTypeDef i2cBusMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef i2cBusMemWrite(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+
+bool i2cBusRecover(void);
+void i2cBusReport(void);
+
+#endif /* INC_I2CBUS_H_ */
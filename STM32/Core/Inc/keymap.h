@@ -0,0 +1,44 @@
+/*
+ * keymap.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Maps (mode, key, event type) to an action id of the application. The entries are a plain
+ * list, keymapLoad expands them into a dense table so a lookup is one array access.
+ * A panel variant with other wiring or other keys only needs its own entry list.
+ */
+
+#ifndef INC_KEYMAP_H_
+#define INC_KEYMAP_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+#include "button.h"
+
+/* Private define */
+#define KEYMAP_MODES			8	// modes of the application, mode ids are 0 to KEYMAP_MODES - 1
+#define KEYMAP_NONE				0	// action of unmapped events
+
+/* event masks of an entry */
+#define KEYMAP_ON(type)			(1 << (type))
+#define KEYMAP_PRESS			KEYMAP_ON(BUTTON_PRESS)
+#define KEYMAP_DOWN				(KEYMAP_ON(BUTTON_PRESS) | KEYMAP_ON(BUTTON_REPEAT))	// press and auto repeat
+#define KEYMAP_LONG				KEYMAP_ON(BUTTON_LONG)
+
+typedef struct
+{
+	uint8_t mode;
+	uint8_t key;
+	uint8_t events;		// KEYMAP_ON bits of the event types that trigger the action
+	uint8_t action;		// application action id, not KEYMAP_NONE
+}Keymap_Entry;
+
+/* Functions */
+void initKeymap(void);
+
+bool keymapLoad(const Keymap_Entry *pEntries, uint16_t count);
+uint8_t keymapLookup(uint8_t mode, const Button_Event *pEvent);
+
+#endif /* INC_KEYMAP_H_ */
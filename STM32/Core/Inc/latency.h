@@ -0,0 +1,55 @@
+/*
+ * latency.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Press to photon latency of the user interface, per mode of the application (keymap mode id).
+ * A sample has three timestamps:
+ *   edge		the button scan that produced the debounced event, the key went down
+ *   			3 to 4 scans (30-40ms) before it
+ *   dispatch	the ui task mapped the event to an action
+ *   done		the ui task finished the lcd and 7 segment update of the action, after a mode
+ *   			change that is the end of the first full draw of the new screen.
+ *   			the 7 segment shows it within one refresh (4ms) from there
+ * wait is edge to dispatch (scan period and scheduling), ui is dispatch to done (lcd redraw).
+ */
+
+#ifndef INC_LATENCY_H_
+#define INC_LATENCY_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+#include "button.h"
+#include "keymap.h"
+
+/* Private define */
+/* histogram of edge to done: bucket 0 < 1024us, bucket n < 1024us << n, last bucket collects the rest */
+#define LATENCY_HISTOGRAM_SIZE		10
+#define LATENCY_HISTOGRAM_SHIFT		10
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t wait_max;		// us, edge to dispatch
+	uint64_t wait_total;
+	uint32_t ui_max;		// us, dispatch to done
+	uint64_t ui_total;
+	uint32_t total_max;		// us, edge to done
+	uint32_t histogram[LATENCY_HISTOGRAM_SIZE];
+}Latency_Stats;
+
+/* Variables */
+extern Latency_Stats latency_stats[KEYMAP_MODES];
+
+/* Functions */
+void initLatency(void);
+
+void latencyDispatch(uint8_t mode, const Button_Event *pEvent);
+void latencyComplete(void);
+void latencyReset(void);
+
+void latencyReport(void);
+
+#endif /* INC_LATENCY_H_ */
@@ -10,6 +10,7 @@
 
 /* Includes */
 #include "gpio.h"
+#include "dataStructure.h"
 
 /* LCD size */
 #define LCD_WIDTH	240
@@ -78,6 +79,7 @@ void lcdSetDisplayOn(void);
 void lcdSetDisplayOff(void);
 uint16_t lcdReadPoint(uint16_t x, uint16_t y);
 void lcdClear(uint16_t color);
+bool lcdClearStep(uint16_t color, uint16_t rows);
 
 void lcdFill(uint16_t xsta, uint16_t ysta, uint16_t xend, uint16_t yend,
 		uint16_t color);
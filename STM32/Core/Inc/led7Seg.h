@@ -9,6 +9,40 @@
 #define INC_LED7SEG_H_
 
 #include "stdint.h"
+#include "dataStructure.h"
+
+/* Define LED7SEG_USE_DMA (-DLED7SEG_USE_DMA) to refresh the display from TIM8 and DMA (see spiBus.h)
+ * instead of one SPI transfer in every TIM4 interrupt. The setters then edit the frame buffer
+ * and led7SegDisplay only runs the blink clock, rebuilding the frames when the blink phase flips.
+ *
+ * Brightness uses binary code modulation in the DMA build: the time of a digit is cut into
+ * LED7SEG_BCM_SLOTS equal slots, brightness bit n lights the digit for 2^n of them. TIM8 has a
+ * fixed period, so the weights are made of repeated frames, 60 frames and a 3.84ms refresh.
+ * Without DMA the 1ms tick is too coarse for it, level 0 blanks the digit and any other is full. */
+#define LED7SEG_DIGITS			4
+#define LED7SEG_BRIGHTNESS_BITS	4
+#define LED7SEG_BRIGHTNESS_MAX	((1 << LED7SEG_BRIGHTNESS_BITS) - 1)	// level 15, the 25% duty of plain multiplexing
+#define LED7SEG_BCM_SLOTS		LED7SEG_BRIGHTNESS_MAX
+#define LED7SEG_SLOT_US			64		// > SPI_BUS_LOAD_US + SPI_BUS_LATCH_END_US
+#define LED7SEG_PERIOD_US		(LED7SEG_SLOT_US * LED7SEG_BCM_SLOTS)	// time each digit owns per refresh
+#define LED7SEG_ALL				0xff	// position of led7SegSetBrightness for every digit
+
+/* segment bits of a glyph, lit when set. the 74HC595 drives them active low, led7SegShowSegments takes
+ * the inverted byte per digit, digit 0 (left) in the low byte */
+#define LED7SEG_SEG_A			0x80	// top, then clockwise
+#define LED7SEG_SEG_B			0x40
+#define LED7SEG_SEG_C			0x20
+#define LED7SEG_SEG_D			0x10
+#define LED7SEG_SEG_E			0x08
+#define LED7SEG_SEG_F			0x04
+#define LED7SEG_SEG_G			0x02	// middle
+#define LED7SEG_SEG_DP			0x01
+
+/* blink masks: digit n is bit n, leds use the bits of led7SegBlink */
+#define LED7SEG_BLINK_DEBUG		0x07	// the three debug leds 6, 7, 8
+#define LED7SEG_BLINK_COLON		0x08
+#define LED7SEG_BLINK_PERIOD_MS	2000
+#define LED7SEG_BLINK_ON_MS		1000	// shown for the first part of the period, hidden for the rest
 
 void initLed7Seg(void);
 void led7SegTurnOff(uint8_t position);
@@ -20,4 +54,23 @@ void led7SegDisplay();
 void led7SegDebugTurnOff(uint8_t index);
 void led7SegDebugTurnOn(uint8_t index);
 
+void led7SegBlink(uint8_t digits, uint8_t leds);
+void led7SegSetBlinkTiming(uint16_t period_ms, uint16_t on_ms);
+
+uint8_t led7SegGlyph(char c);
+void led7SegShowSegments(uint32_t digits);
+void led7SegShowText(const char *text);
+void led7SegShowTime(uint8_t high, uint8_t low);
+void led7SegShowCountdown(uint32_t seconds);
+void led7SegShowTemperature(int16_t temperature);
+
+void led7SegScroll(const char *text, uint16_t step_ms);
+void led7SegScrollStop(void);
+bool led7SegIsScrolling(void);
+
+void led7SegSetBrightness(uint8_t position, uint8_t level);
+uint8_t led7SegGetBrightness(uint8_t position);
+
+void led7SegReport(void);
+
 #endif /* INC_LED7SEG_H_ */
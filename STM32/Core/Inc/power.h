@@ -0,0 +1,27 @@
+/*
+ * power.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_POWER_H_
+#define INC_POWER_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define POWER_WINDOW_MS		1000 // cpu load is averaged over this window
+
+/* Functions */
+void initPower(void);
+
+void powerIdle(void);
+void powerUpdateLoad(void);
+uint16_t powerGetLoad(void);
+
+void powerReport(void);
+
+#endif /* INC_POWER_H_ */
@@ -0,0 +1,68 @@
+/*
+ * profiler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Define PROFILER_ENABLE (-DPROFILER_ENABLE) to time the zones below with the DWT cycle counter.
+ * Without it PROFILER_BEGIN/PROFILER_END expand to nothing and no code or RAM is used.
+ * Zones are for main context only, they nest up to PROFILER_MAX_DEPTH deep.
+ */
+
+#ifndef INC_PROFILER_H_
+#define INC_PROFILER_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define PROFILER_MAX_DEPTH		8
+
+/* X(id, name): add a zone here, then wrap the code with PROFILER_BEGIN(id) / PROFILER_END(id) */
+#define PROFILER_ZONES(X) \
+	X(PROF_TASK_EVENT,		"taskEvent") \
+	X(PROF_TASK_INPUT,		"taskInput") \
+	X(PROF_TASK_TEMP,		"taskTemperature") \
+	X(PROF_TASK_UI,			"taskUi") \
+	X(PROF_LCD_CLEAR,		"lcdClear") \
+	X(PROF_DISPLAY_CLOCK,	"displayClock") \
+	X(PROF_DS3231_POLL,		"ds3231Poll") \
+	X(PROF_DS3231_READ_TIME,"ds3231ReadTime") \
+	X(PROF_BUTTON_SCAN,		"buttonScan")
+
+typedef enum Profiler_Zone
+{
+#define PROFILER_ZONE_ID(id, name) id,
+	PROFILER_ZONES(PROFILER_ZONE_ID)
+#undef PROFILER_ZONE_ID
+	PROF_ZONE_COUNT
+}Profiler_Zone;
+
+typedef struct
+{
+	uint32_t count;
+	uint32_t min;		// cycles, including nested zones
+	uint32_t max;
+	uint64_t total;
+	uint64_t self;		// cycles not spent in nested zones
+}Profiler_Stats;
+
+#ifdef PROFILER_ENABLE
+#define PROFILER_BEGIN(zone)	profilerBegin(zone)
+#define PROFILER_END(zone)		profilerEnd(zone)
+#else
+#define PROFILER_BEGIN(zone)	((void)0)
+#define PROFILER_END(zone)		((void)0)
+#endif /* PROFILER_ENABLE */
+
+/* Functions */
+void initProfiler(void);
+
+void profilerBegin(Profiler_Zone zone);
+void profilerEnd(Profiler_Zone zone);
+void profilerReset(void);
+
+void profilerReport(void);
+
+#endif /* INC_PROFILER_H_ */
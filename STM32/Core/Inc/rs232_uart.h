@@ -16,9 +16,6 @@
 #include "utils.h"
 #include "dataStructure.h"
 
-/* Varialbes */
-extern Ring_Buffer rs232_rbuffer;
-
 /* Functions */
 void initRS232(void);
 
@@ -27,6 +24,4 @@ void rs232SendBytes(uint8_t* bytes, uint16_t size);
 void rs232SendNum(uint32_t num);
 void rs232SendNumPercent(uint32_t num);
 
-bool rs232GetFlag(void);
-
 #endif /* INC_RS232_UART_H_ */
@@ -9,17 +9,47 @@
 #define INC_STIMER_H_
 
 #include <stdint.h>
+#include "dataStructure.h"
 
-#define TIMER_2_CYCLES		1
-#define TIMER_4_CYCLES		1
+#define STIMER_TICK_MS			1 // TIM4 update period
 
-void initTimer2(void);
-void initTimer4(void);
+/* two level timing wheel, level 0 counts ticks, level 1 counts level 0 turns */
+#define STIMER_WHEEL0_BITS		8
+#define STIMER_WHEEL1_BITS		6
+#define STIMER_WHEEL0_SIZE		(1 << STIMER_WHEEL0_BITS)
+#define STIMER_WHEEL1_SIZE		(1 << STIMER_WHEEL1_BITS)
+#define STIMER_WHEEL0_MASK		(STIMER_WHEEL0_SIZE - 1)
+#define STIMER_WHEEL1_MASK		(STIMER_WHEEL1_SIZE - 1)
+/* longer timers are parked in the farthest level 1 slot and cascaded again */
+#define STIMER_WHEEL_SPAN		((STIMER_WHEEL1_SIZE - 1) << STIMER_WHEEL0_BITS)
 
-void sTimer2Set(uint16_t delay, uint16_t period);
-void sTimer4Set(uint16_t delay, uint16_t period);
+/* called from the tick interrupt, keep it short */
+typedef void (*STimer_Callback)(void *context);
 
-uint8_t sTimer2GetFlag(void);
-uint8_t sTimer4GetFlag(void);
+typedef struct STimer
+{
+	struct STimer *next;
+	struct STimer *prev;
+	struct STimer **slot;		// head of the wheel slot holding the timer, O(1) unlink
+
+	uint32_t expire;			// absolute tick of the next expiration
+	uint32_t period;			// ticks between expirations, 0 = one shot
+	STimer_Callback callback;	// NULL = flag mode, poll with sTimerGetFlag
+	void *context;
+
+	volatile bool active;
+	volatile bool flag;
+	volatile uint16_t overruns;	// expirations that found the previous one not yet consumed
+}STimer;
+
+void initSTimer(void);
+
+void sTimerStart(STimer *pTimer, uint32_t delay, uint32_t period, STimer_Callback callback, void *context);
+void sTimerStop(STimer *pTimer);
+bool sTimerGetFlag(STimer *pTimer);
+bool sTimerIsActive(const STimer *pTimer);
+
+uint32_t sTimerGetTick(void);
+void sTimerTick(void);
 
 #endif /* INC_STIMER_H_ */
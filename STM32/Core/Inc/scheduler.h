@@ -0,0 +1,67 @@
+/*
+ * scheduler.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_SCHEDULER_H_
+#define INC_SCHEDULER_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define SCHEDULER_MAX_TASKS		8
+#define SCHEDULER_NO_TASK		0xff
+
+typedef enum Task_Priority
+{
+	TASK_PRIORITY_HIGH,
+	TASK_PRIORITY_NORMAL,
+	TASK_PRIORITY_LOW,
+	TASK_PRIORITY_COUNT
+}Task_Priority;
+
+/* tasks run to completion, long work returns TASK_YIELD and continues on the next dispatch */
+typedef enum Task_Result
+{
+	TASK_DONE,
+	TASK_YIELD
+}Task_Result;
+
+typedef Task_Result (*Task_Function)(void);
+typedef void (*Idle_Hook)(void);
+
+typedef struct
+{
+	const char *name;
+	Task_Function function;
+	Task_Priority priority;
+	uint32_t period;		// ms between releases, 0 = released by schedulerTrigger only
+	uint32_t deadline;		// ms after release the task has to be done
+
+	uint32_t next_release;
+	uint32_t release;		// tick of the pending release
+	volatile bool ready;
+
+	uint32_t runs;
+	uint32_t misses;		// releases finished after their deadline
+	uint32_t max_lateness;	// ms from release to completion, worst case
+}Task;
+
+/* Variables */
+extern Task scheduler_tasks[SCHEDULER_MAX_TASKS];
+
+/* Functions */
+void initScheduler(void);
+
+uint8_t schedulerAdd(const char *name, Task_Function function, Task_Priority priority, uint32_t period, uint32_t deadline);
+void schedulerTrigger(uint8_t id);
+void schedulerSetIdleHook(Idle_Hook hook);
+void schedulerRun(void);
+
+void schedulerReport(void);
+
+#endif /* INC_SCHEDULER_H_ */
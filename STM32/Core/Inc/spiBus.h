@@ -0,0 +1,53 @@
+/*
+ * spiBus.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * SPI1 drives two shift register chains at once: MOSI feeds the 74HC595 of the 7 segment
+ * display (latched by LD_LATCH), MISO reads the 74HC165 of the buttons (loaded by BTN_LOAD).
+ * Every transfer updates both, so one full duplex transfer per 1ms tick serves the display
+ * and samples the buttons.
+ *
+ * spiBusStartStream hands the bus to hardware for good: TIM8 paces a circular list of frames,
+ * DMA2 writes them to SPI1, pulses LD_LATCH and BTN_LOAD through BSRR and stores the button word.
+ * DMA2 streams 0, 1, 2, 3, 4 and 7 and TIM8 are used, the frames must not be in CCMRAM.
+ */
+
+#ifndef INC_SPIBUS_H_
+#define INC_SPIBUS_H_
+
+/* Includes */
+#include <stdint.h>
+#include "spi.h"
+#include "dataStructure.h"
+
+/* Private define */
+#define SPI_BUS_TIMEOUT			1 // ms, HAL timeout of one 16 bit transfer
+
+/* stream mode, us from the TIM8 update that starts the transfer (16 bit take < 1us) */
+#define SPI_BUS_LATCH_US		4	// LD_LATCH rises, display shows the new frame
+#define SPI_BUS_LATCH_END_US	8	// LD_LATCH falls
+#define SPI_BUS_LOAD_US			16	// before the end of the period: BTN_LOAD falls, keys are sampled
+#define SPI_BUS_LOAD_END_US		8	// before the end of the period: BTN_LOAD rises, ready to shift
+
+typedef struct
+{
+	uint32_t transfers;
+	uint32_t errors;
+	uint32_t collisions;	// transfers refused because another context owned the bus
+}SPI_Bus_Stats;
+
+/* Variables */
+extern SPI_Bus_Stats spi_bus_stats;
+
+/* Functions */
+void initSPIBus(void);
+
+bool spiBusTransfer(uint16_t output, uint16_t *pInput);
+uint16_t spiBusGetInput(void);
+
+void spiBusStartStream(const volatile uint16_t *pFrames, uint16_t count, uint16_t period_us);
+bool spiBusIsStreaming(void);
+
+#endif /* INC_SPIBUS_H_ */
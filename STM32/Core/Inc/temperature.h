@@ -0,0 +1,50 @@
+/*
+ * temperature.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_TEMPERATURE_H_
+#define INC_TEMPERATURE_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define TEMP_HISTORY_SIZE		16 // number of samples kept for min/max/mean
+#define TEMP_CONV_TIMEOUT		10 // number of temperatureProcess() calls before a conversion is given up
+#define TEMP_REQUEST_TICKS	20 // word clock requests a conversion every 20 x 500ms
+
+/* temperature are stored in fixed point: 1 unit = 0.25 Celsius */
+
+typedef enum Temp_State
+{
+	TEMP_IDLE,
+	TEMP_WAIT_READY,
+	TEMP_CONVERTING
+}Temp_State;
+
+typedef struct
+{
+	int16_t latest;
+	int16_t min;
+	int16_t max;
+	int16_t mean;
+	uint8_t count; // number of valid samples in history, up to TEMP_HISTORY_SIZE
+}Temp_Stats;
+
+/* Functions */
+void initTemperature(void);
+
+void temperatureRequest(void);
+bool temperatureProcess(void);
+bool temperatureIsValid(void);
+
+void temperatureGetStats(Temp_Stats *pStats);
+int16_t temperatureGetLatest(void);
+
+void temperatureReport(void);
+
+#endif /* INC_TEMPERATURE_H_ */
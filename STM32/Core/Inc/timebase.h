@@ -0,0 +1,29 @@
+/*
+ * timebase.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef INC_TIMEBASE_H_
+#define INC_TIMEBASE_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define TIMEBASE_HZ			1000000 // TIM2 counts microseconds: 84MHz timer clock / 84
+
+/* Functions */
+void initTimebase(void);
+
+uint64_t timebaseGetUs(void);
+uint32_t timebaseGetUs32(void);
+uint64_t timebaseElapsedUs(uint64_t since);
+void timebaseDelayUs(uint32_t us);
+bool timebaseTimeout(uint64_t start, uint32_t timeout_us);
+
+void timebaseOverflow(void);
+
+#endif /* INC_TIMEBASE_H_ */
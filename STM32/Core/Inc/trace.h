@@ -0,0 +1,72 @@
+/*
+ * trace.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Define TRACE_ENABLE (-DTRACE_ENABLE) to record the events below into a ring in CCMRAM.
+ * Without it TRACE expands to nothing and no code or RAM is used.
+ * Records can be written from interrupts and main context, the oldest ones are overwritten.
+ * CCMRAM is not cleared by the startup code, so the ring of the previous run survives a reset
+ * and is kept behind a TRACE_RESET record. Dump it with 't' and convert it on the host with
+ * tools/trace_to_json.py, which has to be updated together with the tables below.
+ */
+
+#ifndef INC_TRACE_H_
+#define INC_TRACE_H_
+
+/* Includes */
+#include <stdint.h>
+#include "dataStructure.h"
+
+/* Private define */
+#define TRACE_SIZE			4096		// records, power of 2, 48KB: about 2s of history with the 1ms tick traced
+#define TRACE_MASK			(TRACE_SIZE - 1)
+#define TRACE_MAGIC			0x54524331	// "TRC1", marks a ring left by a previous run
+#define TRACE_VERSION		1
+
+typedef enum Trace_Event
+{
+	TRACE_RESET,		// arg0: TRACE_VERSION
+	TRACE_ISR_ENTER,	// arg0: IRQn
+	TRACE_ISR_EXIT,		// arg0: IRQn
+	TRACE_MODE,			// arg0: previous mode, arg1: new mode
+	TRACE_I2C_BEGIN,	// arg0: 1 write 0 read, arg1: device << 16 | register << 8 | size
+	TRACE_I2C_END,		// arg0: HAL status
+	TRACE_LCD_BEGIN,	// arg0: Trace_Lcd, arg1: pixels
+	TRACE_LCD_END		// arg0: Trace_Lcd
+}Trace_Event;
+
+/* lcd command batches, one window address followed by a pixel stream or a group of them */
+typedef enum Trace_Lcd
+{
+	TRACE_LCD_CLEAR,
+	TRACE_LCD_FILL,
+	TRACE_LCD_CHAR,
+	TRACE_LCD_PICTURE,
+	TRACE_LCD_CIRCLE
+}Trace_Lcd;
+
+typedef struct
+{
+	uint32_t timestamp;		// us, low 32 bit of the TIM2 timebase
+	uint16_t id;			// Trace_Event
+	uint16_t arg0;
+	uint32_t arg1;
+}Trace_Record;
+
+#ifdef TRACE_ENABLE
+#define TRACE(id, arg0, arg1)	traceRecord(id, arg0, arg1)
+#else
+#define TRACE(id, arg0, arg1)	((void)0)
+#endif /* TRACE_ENABLE */
+
+/* Functions */
+void initTrace(void);
+
+void traceRecord(Trace_Event id, uint16_t arg0, uint32_t arg1);
+void traceClear(void);
+
+void traceDump(void);
+
+#endif /* INC_TRACE_H_ */
@@ -13,4 +13,10 @@
 uint8_t BCD2DEC(uint8_t data);
 uint8_t DEC2BCD(uint8_t data);
 
+void initCycleCounter(void);
+uint32_t getCycleCounter(void);
+
+uint8_t histogramBucket(uint32_t value, uint8_t shift, uint8_t size);
+void histogramReport(const uint32_t *histogram, uint8_t shift, uint8_t size);
+
 #endif /* INC_UTILS_H_ */
@@ -0,0 +1,390 @@
+/*
+ * alarm.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "alarm.h"
+#include "ds3231.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initAlarm(void);
+
+uint8_t alarmAdd(const Alarm *pAlarm, Epoch now);
+bool alarmRemove(uint8_t slot);
+void alarmClear(void);
+
+uint8_t alarmProcess(Epoch now);
+void alarmReschedule(Epoch now);
+
+Epoch alarmNextFire(const Alarm *pAlarm, Epoch after);
+uint8_t alarmGetNext(void);
+uint8_t alarmCount(void);
+
+void alarmReport(void);
+
+static void alarmSwap(uint8_t i, uint8_t j);
+static void alarmSiftUp(uint8_t i);
+static void alarmSiftDown(uint8_t i);
+static void alarmHeapRemove(uint8_t i);
+static void alarmProgramNext(void);
+
+/* Variables */
+Alarm alarm_table[ALARM_MAX];
+
+static uint8_t alarm_heap[ALARM_MAX];		// slots ordered as a binary min-heap on next_fire
+static uint8_t alarm_heap_index[ALARM_MAX];	// position of each slot in alarm_heap, ALARM_NONE if slot is free
+static uint8_t alarm_count = 0;
+static Epoch alarm_programmed = ALARM_NEVER;	// fire time currently loaded into ds3231 alarm 1
+
+/* Functions */
+void initAlarm()
+{
+	alarmClear();
+}
+
+/**
+ * @brief	insert an alarm, only ds3231 alarm 1 is reprogrammed and only if the earliest alarm changed
+ * @param	now current time, the first fire is strictly after it
+ * @retval	slot of the alarm, ALARM_NONE if table is full or the alarm never fires
+ */
+uint8_t alarmAdd(const Alarm *pAlarm, Epoch now)
+{
+	if(alarm_count >= ALARM_MAX)
+	{
+		return ALARM_NONE;
+	}
+
+	uint8_t slot = 0;
+	while(alarm_heap_index[slot] != ALARM_NONE)
+	{
+		slot++;
+	}
+
+	alarm_table[slot] = *pAlarm;
+	if(pAlarm->repeat == ALARM_ONCE && pAlarm->once == 0)
+	{
+		Alarm daily = *pAlarm;
+		daily.repeat = ALARM_DAILY;
+		alarm_table[slot].once = alarmNextFire(&daily, now);
+	}
+
+	alarm_table[slot].next_fire = alarmNextFire(&alarm_table[slot], now);
+	if(alarm_table[slot].next_fire == ALARM_NEVER)
+	{
+		return ALARM_NONE;
+	}
+
+	alarm_heap[alarm_count] = slot;
+	alarm_heap_index[slot] = alarm_count;
+	alarm_count++;
+	alarmSiftUp(alarm_count - 1);
+
+	alarmProgramNext();
+	return slot;
+}
+
+bool alarmRemove(uint8_t slot)
+{
+	if(slot >= ALARM_MAX || alarm_heap_index[slot] == ALARM_NONE)
+	{
+		return false;
+	}
+
+	alarmHeapRemove(alarm_heap_index[slot]);
+	alarmProgramNext();
+	return true;
+}
+
+void alarmClear()
+{
+	for(uint8_t slot = 0; slot < ALARM_MAX; slot++)
+	{
+		alarm_heap_index[slot] = ALARM_NONE;
+	}
+	alarm_count = 0;
+	alarm_programmed = ALARM_NEVER;
+}
+
+/**
+ * @brief	fire every alarm due at now, call when ds3231 alarm 1 flag is raised.
+ * 			only the heap root is looked at, each fired alarm is rescheduled in O(log n).
+ * 			alarm 1 matches date but not month, an early match simply fires nothing.
+ * @retval	bit mask of fired slots
+ */
+uint8_t alarmProcess(Epoch now)
+{
+	uint8_t fired = 0;
+
+	while(alarm_count > 0 && alarm_table[alarm_heap[0]].next_fire <= now)
+	{
+		uint8_t slot = alarm_heap[0];
+		fired |= 1 << slot;
+
+		Epoch next = alarmNextFire(&alarm_table[slot], now);
+		if(next == ALARM_NEVER)
+		{
+			alarmHeapRemove(0);
+		}
+		else
+		{
+			alarm_table[slot].next_fire = next;
+			alarmSiftDown(0);
+		}
+	}
+
+	alarmProgramNext();
+	return fired;
+}
+
+/**
+ * @brief	recompute every next fire after the clock was set, one shot alarms in the past are dropped
+ */
+void alarmReschedule(Epoch now)
+{
+	uint8_t count = alarm_count;
+	alarm_count = 0;
+
+	for(uint8_t i = 0; i < count; i++)
+	{
+		uint8_t slot = alarm_heap[i];
+		Epoch next = alarmNextFire(&alarm_table[slot], now);
+		if(next == ALARM_NEVER)
+		{
+			alarm_heap_index[slot] = ALARM_NONE;
+			continue;
+		}
+
+		alarm_table[slot].next_fire = next;
+		alarm_heap[alarm_count] = slot;
+		alarm_heap_index[slot] = alarm_count;
+		alarm_count++;
+	}
+
+	// bottom-up heapify, O(n)
+	for(uint8_t i = alarm_count / 2; i > 0; i--)
+	{
+		alarmSiftDown(i - 1);
+	}
+
+	alarm_programmed = ALARM_NEVER;
+	alarmProgramNext();
+}
+
+/**
+ * @brief	first time strictly after 'after' the alarm rings
+ * @retval	ALARM_NEVER for a one shot alarm already passed or a weekly alarm without any day
+ */
+Epoch alarmNextFire(const Alarm *pAlarm, Epoch after)
+{
+	int32_t day = (int32_t)(after / EPOCH_SECONDS_PER_DAY);
+	int32_t second_of_day = pAlarm->hour * EPOCH_SECONDS_PER_HOUR + pAlarm->minute * EPOCH_SECONDS_PER_MINUTE + pAlarm->second;
+
+	switch(pAlarm->repeat)
+	{
+		case ALARM_ONCE:
+		{
+			return (pAlarm->once > after) ? pAlarm->once : ALARM_NEVER;
+		}
+		case ALARM_DAILY:
+		{
+			Epoch next = (Epoch)day * EPOCH_SECONDS_PER_DAY + second_of_day;
+			return (next > after) ? next : next + EPOCH_SECONDS_PER_DAY;
+		}
+		case ALARM_WEEKLY:
+		{
+			for(uint8_t i = 0; i <= 7; i++)
+			{
+				Epoch next = (Epoch)(day + i) * EPOCH_SECONDS_PER_DAY + second_of_day;
+				if(next > after && (pAlarm->weekdays & (1 << (epochWeekday(day + i) - 1))))
+				{
+					return next;
+				}
+			}
+			return ALARM_NEVER;
+		}
+		case ALARM_MONTHLY:
+		{
+			uint16_t year;
+			uint8_t month;
+			uint8_t date;
+			epochCivilFromDays(day, &year, &month, &date);
+
+			// any date up to 31 exists at least once in 12 months
+			for(uint8_t i = 0; i <= 12; i++)
+			{
+				if(pAlarm->date >= 1 && pAlarm->date <= epochDaysInMonth(month, year))
+				{
+					Epoch next = (Epoch)epochDaysFromCivil(year, month, pAlarm->date) * EPOCH_SECONDS_PER_DAY + second_of_day;
+					if(next > after)
+					{
+						return next;
+					}
+				}
+
+				if(++month > 12)
+				{
+					month = 1;
+					year++;
+				}
+			}
+			return ALARM_NEVER;
+		}
+		default:
+		{
+			return ALARM_NEVER;
+		}
+	}
+}
+
+/**
+ * @retval	slot of the earliest alarm, ALARM_NONE if no alarm is scheduled
+ */
+uint8_t alarmGetNext()
+{
+	return (alarm_count > 0) ? alarm_heap[0] : ALARM_NONE;
+}
+
+uint8_t alarmCount()
+{
+	return alarm_count;
+}
+
+void alarmReport()
+{
+	rs232SendString((void*)"Alarm count:");
+	rs232SendNum(alarm_count);
+	rs232SendString((void*)"\r\n");
+
+	for(uint8_t i = 0; i < alarm_count; i++)
+	{
+		Time next;
+		uint8_t slot = alarm_heap[i];
+		epochToTime(alarm_table[slot].next_fire, &next);
+
+		rs232SendString((void*)" slot:");
+		rs232SendNum(slot);
+		rs232SendString((void*)" repeat:");
+		rs232SendNum(alarm_table[slot].repeat);
+		rs232SendString((void*)" next:");
+		rs232SendNum(next.year);
+		rs232SendString((void*)"-");
+		rs232SendNum(next.month);
+		rs232SendString((void*)"-");
+		rs232SendNum(next.date);
+		rs232SendString((void*)" ");
+		rs232SendNum(next.hour);
+		rs232SendString((void*)":");
+		rs232SendNum(next.minute);
+		rs232SendString((void*)":");
+		rs232SendNum(next.second);
+		rs232SendString((void*)"\r\n");
+	}
+}
+
+static void alarmSwap(uint8_t i, uint8_t j)
+{
+	uint8_t slot = alarm_heap[i];
+	alarm_heap[i] = alarm_heap[j];
+	alarm_heap[j] = slot;
+
+	alarm_heap_index[alarm_heap[i]] = i;
+	alarm_heap_index[alarm_heap[j]] = j;
+}
+
+static void alarmSiftUp(uint8_t i)
+{
+	while(i > 0)
+	{
+		uint8_t parent = (i - 1) / 2;
+		if(alarm_table[alarm_heap[parent]].next_fire <= alarm_table[alarm_heap[i]].next_fire)
+		{
+			break;
+		}
+		alarmSwap(i, parent);
+		i = parent;
+	}
+}
+
+static void alarmSiftDown(uint8_t i)
+{
+	while(1)
+	{
+		uint8_t smallest = i;
+		uint8_t left = 2 * i + 1;
+		uint8_t right = 2 * i + 2;
+
+		if(left < alarm_count && alarm_table[alarm_heap[left]].next_fire < alarm_table[alarm_heap[smallest]].next_fire)
+		{
+			smallest = left;
+		}
+		if(right < alarm_count && alarm_table[alarm_heap[right]].next_fire < alarm_table[alarm_heap[smallest]].next_fire)
+		{
+			smallest = right;
+		}
+		if(smallest == i)
+		{
+			return;
+		}
+		alarmSwap(i, smallest);
+		i = smallest;
+	}
+}
+
+static void alarmHeapRemove(uint8_t i)
+{
+	uint8_t slot = alarm_heap[i];
+	uint8_t last = alarm_count - 1;
+
+	if(i != last)
+	{
+		alarmSwap(i, last);
+	}
+	alarm_count--;
+	alarm_heap_index[slot] = ALARM_NONE;
+
+	if(i < alarm_count)
+	{
+		alarmSiftDown(i);
+		alarmSiftUp(i);
+	}
+}
+
+/**
+ * @brief	load the heap root into ds3231 alarm 1 (match second, minute, hour and date), skipped if already loaded
+ */
+static void alarmProgramNext()
+{
+	if(alarm_count == 0)
+	{
+		alarm_programmed = ALARM_NEVER;
+		return;
+	}
+
+	Epoch next_fire = alarm_table[alarm_heap[0]].next_fire;
+	if(next_fire == alarm_programmed)
+	{
+		return;
+	}
+
+	Time next;
+	epochToTime(next_fire, &next);
+
+	ds3231SetSecA1(next.second);
+	ds3231SetMinA1(next.minute);
+	ds3231SetHourA1(next.hour);
+	ds3231SetDateA1(next.date);
+	ds3231SetModeA1(DS3231_A1_MATCH_S_M_H_DATE);
+
+	alarm_programmed = next_fire;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
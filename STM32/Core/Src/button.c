@@ -6,55 +6,241 @@
  */
 
 #include "button.h"
+#include "spiBus.h"
+#include "sTimer.h"
+#include "profiler.h"
+#include "timebase.h"
+#include "rs232_uart.h"
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif
 
+typedef struct
+{
+	bool long_sent;
+	uint16_t repeat_ms;		// current repeat interval
+	uint32_t held_ms;
+	uint32_t next_repeat_ms;
+}Button_State;
+
+static uint16_t buttonRemap(uint16_t sample);
+static void buttonUpdate(uint8_t key, bool edge, uint32_t tick);
+static bool buttonPost(uint8_t key, Button_Event_Type type, uint32_t tick);
+
 /* Variables */
-uint16_t button_count[16] = {0};
-static uint16_t button_spi_buffer = 0x0000;
+/* one bit per key, bit n is key n: 2 bit vertical counter per key and the debounced state */
+static uint16_t button_count_0 = 0xffff;
+static uint16_t button_count_1 = 0xffff;
+static uint16_t button_pressed = 0x0000;
+static uint32_t button_scan_us = 0;	// time of the scan in progress
+
+/* bit order reversed within a nibble */
+static const uint8_t button_nibble_reverse[16] =
+{
+	0x0, 0x8, 0x4, 0xc, 0x2, 0xa, 0x6, 0xe,
+	0x1, 0x9, 0x5, 0xd, 0x3, 0xb, 0x7, 0xf
+};
+
+static const Button_Config button_default_config = {1000, 0, 0, 0};
+static Button_Config button_config[BUTTON_COUNT];
+static Button_State button_state[BUTTON_COUNT];
+
+/* single producer (buttonScan), single consumer (ui) */
+static Button_Event button_queue[BUTTON_QUEUE_SIZE];
+static volatile uint16_t button_queue_head = 0;
+static volatile uint16_t button_queue_tail = 0;
+static uint16_t button_queue_high_water = 0;	// most events waiting at once
+static uint32_t button_queue_posted = 0;
+static uint32_t button_queue_drops = 0;		// events lost because the queue was full
 
 /* Functions */
 /**
- * @brief  	Init matrix button
+ * @brief  	Init matrix button, every key gets a plain press/release/long configuration
  * @param  	None
  * @retval 	None
  */
 void initButton() {
-	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 1);
+	for (uint8_t key = 0; key < BUTTON_COUNT; key++) {
+		button_config[key] = button_default_config;
+		button_state[key] = (Button_State){0};
+	}
+	button_count_0 = 0xffff;
+	button_count_1 = 0xffff;
+	button_pressed = 0x0000;
+	button_queue_head = 0;
+	button_queue_tail = 0;
+	button_queue_high_water = 0;
+	button_queue_posted = 0;
+	button_queue_drops = 0;
 }
 
 /**
- * @brief  	Scan matrix button
+ * @brief  	Scan matrix button, debounce all keys at once and turn changes into events
  * @param  	None
- * @note  	Call every 50ms
+ * @note  	Call every BUTTON_SCAN_MS. a key changes state after 4 equal samples in a row,
+ * 			keys that are released and did not change cost nothing.
+ * 			the sample comes from the display refresh, which reads the buttons every 1ms
  * @retval 	None
  */
 void buttonScan() {
-	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 0);
-	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 1);
-	HAL_SPI_Receive(&hspi1, (void*) &button_spi_buffer, 2, 10);
-
-	int button_index = 0;
-	uint16_t mask = 0x8000;
-	for (int i = 0; i < 16; i++) {
-		if (i >= 0 && i <= 3) {
-			button_index = i + 4;
-		} else if (i >= 4 && i <= 7) {
-			button_index = 7 - i;
-		} else if (i >= 8 && i <= 11) {
-			button_index = i + 4;
+	PROFILER_BEGIN(PROF_BUTTON_SCAN);
+	uint16_t changed = buttonRemap(~spiBusGetInput()) ^ button_pressed;
+
+	// vertical counter: counts down while a key differs from its debounced state, reset when it agrees
+	button_count_0 = ~(button_count_0 & changed);
+	button_count_1 = button_count_0 ^ (button_count_1 & changed);
+	changed &= button_count_0 & button_count_1; // counter rolled over
+	button_pressed ^= changed;
+
+	uint32_t tick = sTimerGetTick();
+	uint32_t active = button_pressed | changed;
+	button_scan_us = timebaseGetUs32();
+	while (active != 0) {
+		uint8_t key = 31 - __CLZ(active);
+		active &= ~(1UL << key);
+		buttonUpdate(key, (changed >> key) & 1, tick);
+	}
+	PROFILER_END(PROF_BUTTON_SCAN);
+}
+
+/**
+ * @brief  	Set long press and repeat timing of one key
+ * @note  	debounce is not configurable, it is the fixed depth of the vertical counter (4 scans) for every key
+ */
+void buttonConfigure(uint8_t key, const Button_Config *pConfig) {
+	if (key < BUTTON_COUNT) {
+		button_config[key] = *pConfig;
+	}
+}
+
+/**
+ * @brief  	Pop the oldest button event
+ * @retval 	false if there is none, pEvent is left untouched
+ */
+bool buttonGetEvent(Button_Event *pEvent) {
+	uint16_t tail = button_queue_tail;
+
+	if (button_queue_head == tail) {
+		return false;
+	}
+
+	__DMB(); // read the event only after seeing the producer's head
+	*pEvent = button_queue[tail & BUTTON_QUEUE_MASK];
+	__DMB(); // slot must be read before the producer may reuse it
+	button_queue_tail = tail + 1;
+	return true;
+}
+
+bool buttonPending() {
+	return button_queue_head != button_queue_tail;
+}
+
+/**
+ * @brief  	Queue a synthetic event as if a scan produced it now, for latency tests without touching the keys
+ * @note  	main context only, like buttonScan
+ * @retval 	false if the key is out of range or the queue is full
+ */
+bool buttonInject(uint8_t key, Button_Event_Type type) {
+	if (key >= BUTTON_COUNT || type == BUTTON_EVENT_NONE || type >= BUTTON_EVENT_TYPE_COUNT) {
+		return false;
+	}
+
+	button_scan_us = timebaseGetUs32();
+	return buttonPost(key, type, sTimerGetTick());
+}
+
+/**
+ * @brief  	Print the queue statistic in the format of eventReport
+ */
+void buttonReport() {
+	rs232SendString((void*)"Button q posted:");
+	rs232SendNum(button_queue_posted);
+	rs232SendString((void*)" high:");
+	rs232SendNum(button_queue_high_water);
+	rs232SendString((void*)" drop:");
+	rs232SendNum(button_queue_drops);
+	rs232SendString((void*)"\r\n");
+}
+
+/**
+ * @brief  	Reorder shift register bits to key numbers
+ * @param  	sample 16 bit word as shifted in, bit 15 first
+ * @retval 	bit n set if key n is in the sample
+ * @note  	the board wires keys 0-3 to bits 8-11, keys 4-7 to bits 15-12,
+ * 			keys 8-11 to bits 0-3 and keys 12-15 to bits 7-4
+ */
+static uint16_t buttonRemap(uint16_t sample) {
+	return ((sample >> 8) & 0x000f)
+			| (button_nibble_reverse[sample >> 12] << 4)
+			| ((sample & 0x000f) << 8)
+			| (button_nibble_reverse[(sample >> 4) & 0x000f] << 12);
+}
+
+/**
+ * @brief  	Advance the hold timing of one key that is pressed or just changed by one scan
+ * @param  	edge true if the debounced state of the key changed in this scan
+ */
+static void buttonUpdate(uint8_t key, bool edge, uint32_t tick) {
+	Button_State *pState = &button_state[key];
+	const Button_Config *pConfig = &button_config[key];
+
+	if (edge) {
+		if (button_pressed & (1 << key)) {
+			pState->held_ms = 0;
+			pState->long_sent = false;
+			pState->next_repeat_ms = pConfig->repeat_delay_ms;
+			pState->repeat_ms = pConfig->repeat_period_ms;
+			(void)buttonPost(key, BUTTON_PRESS, tick);
 		} else {
-			button_index = 23 - i;
+			(void)buttonPost(key, BUTTON_RELEASE, tick);
 		}
-		if (button_spi_buffer & mask)
-			button_count[button_index] = 0;
-		else
-			button_count[button_index]++;
-		mask = mask >> 1;
+		return;
+	}
+
+	pState->held_ms += BUTTON_SCAN_MS;
+
+	if (pConfig->long_ms > 0 && !pState->long_sent && pState->held_ms >= pConfig->long_ms) {
+		pState->long_sent = true;
+		(void)buttonPost(key, BUTTON_LONG, tick);
+	}
+
+	if (pConfig->repeat_delay_ms > 0 && pState->held_ms >= pState->next_repeat_ms) {
+		(void)buttonPost(key, BUTTON_REPEAT, tick);
+
+		// accelerate, but never below one scan
+		pState->next_repeat_ms += (pState->repeat_ms > BUTTON_SCAN_MS) ? pState->repeat_ms : BUTTON_SCAN_MS;
+		pState->repeat_ms -= pState->repeat_ms / 4;
+		if (pState->repeat_ms < pConfig->repeat_min_ms) {
+			pState->repeat_ms = pConfig->repeat_min_ms;
+		}
+	}
+}
+
+static bool buttonPost(uint8_t key, Button_Event_Type type, uint32_t tick) {
+	uint16_t head = button_queue_head;
+	uint16_t count = head - button_queue_tail;
+
+	if (count >= BUTTON_QUEUE_SIZE) {
+		button_queue_drops++;
+		return false; // ui is far behind, losing an event is better than blocking the scan
+	}
+
+	Button_Event *pEvent = &button_queue[head & BUTTON_QUEUE_MASK];
+	pEvent->key = key;
+	pEvent->type = type;
+	pEvent->timestamp = tick;
+	pEvent->time_us = button_scan_us;
+
+	__DMB(); // event must be complete before the consumer can see it
+	button_queue_head = head + 1;
+
+	button_queue_posted++;
+	if (count + 1 > button_queue_high_water) {
+		button_queue_high_water = count + 1;
 	}
+	return true;
 }
 
 #ifdef __cplusplus
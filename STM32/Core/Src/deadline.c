@@ -0,0 +1,145 @@
+/*
+ * deadline.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "deadline.h"
+#include "main.h"
+#include "timebase.h"
+#include "rs232_uart.h"
+#include "utils.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initDeadline(void);
+
+void deadlineMark(Deadline_Job job);
+void deadlineReset(void);
+
+void deadlineReport(void);
+
+/* Variables */
+static const char *const deadline_names[DEADLINE_JOB_COUNT] =
+{
+#define DEADLINE_JOB_NAME(id, name, period, tolerance) name,
+	DEADLINE_JOBS(DEADLINE_JOB_NAME)
+#undef DEADLINE_JOB_NAME
+};
+
+static const uint32_t deadline_periods[DEADLINE_JOB_COUNT] =
+{
+#define DEADLINE_JOB_PERIOD(id, name, period, tolerance) period,
+	DEADLINE_JOBS(DEADLINE_JOB_PERIOD)
+#undef DEADLINE_JOB_PERIOD
+};
+
+static const uint32_t deadline_limits[DEADLINE_JOB_COUNT] =
+{
+#define DEADLINE_JOB_LIMIT(id, name, period, tolerance) period + tolerance,
+	DEADLINE_JOBS(DEADLINE_JOB_LIMIT)
+#undef DEADLINE_JOB_LIMIT
+};
+
+Deadline_Stats deadline_stats[DEADLINE_JOB_COUNT];
+
+/* Functions */
+void initDeadline()
+{
+	deadlineReset();
+}
+
+/**
+ * @brief	timestamp one activation of a periodic job, each job must be marked from one context only
+ * 			(its ISR or its task). the first activation after a reset only starts the measurement.
+ */
+void deadlineMark(Deadline_Job job)
+{
+	uint32_t now = timebaseGetUs32();
+	Deadline_Stats *pStats = &deadline_stats[job];
+
+	if(pStats->count > 0)
+	{
+		uint32_t interval = now - pStats->last;
+		int32_t jitter = (int32_t)(interval - deadline_periods[job]);
+		uint32_t abs_jitter = (jitter < 0) ? -jitter : jitter;
+
+		if(interval > deadline_limits[job])
+		{
+			pStats->misses++;
+		}
+		if(jitter < pStats->min_jitter)
+		{
+			pStats->min_jitter = jitter;
+		}
+		if(jitter > pStats->max_jitter)
+		{
+			pStats->max_jitter = jitter;
+		}
+
+		pStats->histogram[histogramBucket(abs_jitter, DEADLINE_HISTOGRAM_SHIFT, DEADLINE_HISTOGRAM_SIZE)]++;
+	}
+
+	pStats->last = now;
+	pStats->count++;
+}
+
+void deadlineReset()
+{
+	for(uint8_t job = 0; job < DEADLINE_JOB_COUNT; job++)
+	{
+		Deadline_Stats *pStats = &deadline_stats[job];
+		pStats->count = 0;
+		pStats->misses = 0;
+		pStats->min_jitter = INT32_MAX;
+		pStats->max_jitter = INT32_MIN;
+		for(uint8_t bucket = 0; bucket < DEADLINE_HISTOGRAM_SIZE; bucket++)
+		{
+			pStats->histogram[bucket] = 0;
+		}
+	}
+}
+
+/**
+ * @brief	send every job and its non empty histogram buckets over rs232
+ */
+void deadlineReport()
+{
+	for(uint8_t job = 0; job < DEADLINE_JOB_COUNT; job++)
+	{
+		Deadline_Stats *pStats = &deadline_stats[job];
+
+		rs232SendString((void*)deadline_names[job]);
+		rs232SendString((void*)" n:");
+		rs232SendNum(pStats->count);
+		rs232SendString((void*)" miss:");
+		rs232SendNum(pStats->misses);
+		if(pStats->count > 1)
+		{
+			rs232SendString((void*)" jitter:");
+			if(pStats->min_jitter < 0)
+			{
+				rs232SendString((void*)"-");
+			}
+			rs232SendNum((pStats->min_jitter < 0) ? -pStats->min_jitter : pStats->min_jitter);
+			rs232SendString((void*)"..");
+			if(pStats->max_jitter < 0)
+			{
+				rs232SendString((void*)"-");
+			}
+			rs232SendNum((pStats->max_jitter < 0) ? -pStats->max_jitter : pStats->max_jitter);
+			rs232SendString((void*)"us");
+		}
+		rs232SendString((void*)"\r\n");
+
+		histogramReport(pStats->histogram, DEADLINE_HISTOGRAM_SHIFT, DEADLINE_HISTOGRAM_SIZE);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -6,8 +6,10 @@
  */
 
 #include "ds3231.h"
-#include "i2c.h"
+#include "i2cBus.h"
 #include "utils.h"
+#include "profiler.h"
+#include <string.h>
 
 #ifdef __cplusplus
 extern "C"
@@ -17,13 +19,20 @@ extern "C"
 
 #define DS3231_ADDRESS 0x68<<1
 
-void initds3231(void);
+bool initds3231(void);
 
 void ds3231Write(uint8_t address, uint8_t value);
 uint8_t ds3231Read(uint8_t address);
 
 void ds3231ReadTime(void);
+uint8_t ds3231Poll(void);
+static void ds3231DecodeTime(const uint8_t *time_reg);
 float ds3231ReadTemp(void);
+bool ds3231ReadAllRegisters(void);
+bool ds3231ReadBurst(uint8_t address, uint8_t *data, uint8_t size);
+
+bool ds3231StartConversion(void);
+int16_t ds3231DecodeTemp(uint8_t msb_reg, uint8_t lsb_reg);
 
 void ds3231SetSec(uint8_t second);
 void ds3231SetMin(uint8_t minute);
@@ -62,18 +71,24 @@ Time set_alarm_1 = {0, 0, 0, 7, 1};
 Time set_alarm_2 = {0, 0, 0, 7, 1};
 
 uint8_t ds3231_buffer[7];
+uint8_t ds3231_registers[DS3231_REG_COUNT];
+static uint8_t ds3231_alarm_events = 0; // alarm flags collected by ds3231Poll() not yet consumed
 
 /**
  * @brief	init ds3231 real time clock micro controler
+ * @retval	false if ds3231 does not answer after bus recovery and retries, boot continues anyway
  */
-void initds3231()
+bool initds3231()
 {
-	while (HAL_I2C_IsDeviceReady(&hi2c1, DS3231_ADDRESS, 3, 50) != HAL_OK)
-		;
+	if(!i2cBusIsDeviceReady(DS3231_ADDRESS))
+	{
+		return false;
+	}
 	ds3231EnableA1(DS3231_DISABLED);
 	ds3231EnableA2(DS3231_DISABLED);
 	ds3231ClearFlagA1();
 	ds3231ClearFlagA2();
+	return true;
 }
 
 /**
@@ -84,7 +99,7 @@ void initds3231()
 void ds3231Write(uint8_t address, uint8_t value)
 {
 	uint8_t temp = DEC2BCD(value);
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, address, I2C_MEMADD_SIZE_8BIT, &temp, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, address, &temp, 1);
 }
 
 /**
@@ -94,7 +109,7 @@ void ds3231Write(uint8_t address, uint8_t value)
 uint8_t ds3231Read(uint8_t address)
 {
 	uint8_t result;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, address, I2C_MEMADD_SIZE_8BIT, &result, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, address, &result, 1);
 	return BCD2DEC(result);
 }
 
@@ -103,38 +118,126 @@ uint8_t ds3231Read(uint8_t address)
  */
 void ds3231ReadTime()
 {
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, 0x00, I2C_MEMADD_SIZE_8BIT, ds3231_buffer, 7, 10);
+	PROFILER_BEGIN(PROF_DS3231_READ_TIME);
+	i2cBusMemRead(DS3231_ADDRESS, 0x00, ds3231_buffer, 7);
+	ds3231DecodeTime(ds3231_buffer);
+	PROFILER_END(PROF_DS3231_READ_TIME);
+}
+
+/**
+ * @brief	read time, alarm, control and status register (0x00 to 0x0f) in one transaction,
+ * 			decode time into current_time and collect alarm flags.
+ * 			status register is written back only when an alarm flag is set.
+ * @note	call instead of ds3231ReadTime() every tick, raw registers are also stored in ds3231_registers[]
+ * @return	alarm events raised by this poll, DS3231_EVENT_A1 and/or DS3231_EVENT_A2
+ */
+uint8_t ds3231Poll()
+{
+	uint8_t *reg = ds3231_registers;
+	uint8_t events;
+
+	PROFILER_BEGIN(PROF_DS3231_POLL);
+	if(i2cBusMemRead(DS3231_ADDRESS, ADDRESS_SEC, reg, DS3231_POLL_COUNT) != HAL_OK)
+	{
+		PROFILER_END(PROF_DS3231_POLL);
+		return 0;
+	}
+	ds3231DecodeTime(reg);
+
+	events = reg[DS3231_REG_STATUS] & (DS3231_EVENT_A1 | DS3231_EVENT_A2);
+	if(events)
+	{
+		// flags are clear-only: writing 1 leaves a flag untouched so one that rises meanwhile is not lost
+		uint8_t status_reg = (reg[DS3231_REG_STATUS] | (1 << DS3231_OSF) | DS3231_EVENT_A1 | DS3231_EVENT_A2) & ~events;
+		i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_STATUS, &status_reg, 1);
+		ds3231_alarm_events |= events;
+	}
+	PROFILER_END(PROF_DS3231_POLL);
+	return events;
+}
 
-	current_time.second = BCD2DEC(ds3231_buffer[0]);
-	current_time.minute = BCD2DEC(ds3231_buffer[1]);
-	current_time.hour = BCD2DEC(ds3231_buffer[2] & 0x3f);
-	current_time.day = BCD2DEC(ds3231_buffer[3]);
-	current_time.date = BCD2DEC(ds3231_buffer[4]);
-	current_time.month = BCD2DEC(ds3231_buffer[5] & 0x1f);
-	current_time.year = (BCD2DEC(ds3231_buffer[6]) + 2000) + (((ds3231_buffer[5] & 0x80) >> 7) * 100);
+/**
+ * @brief	decode register 0x00 to 0x06 into current_time
+ */
+static void ds3231DecodeTime(const uint8_t *time_reg)
+{
+	current_time.second = BCD2DEC(time_reg[0]);
+	current_time.minute = BCD2DEC(time_reg[1]);
+	current_time.hour = BCD2DEC(time_reg[2] & 0x3f);
+	current_time.day = BCD2DEC(time_reg[3]);
+	current_time.date = BCD2DEC(time_reg[4]);
+	current_time.month = BCD2DEC(time_reg[5] & 0x1f);
+	current_time.year = (BCD2DEC(time_reg[6]) + 2000) + (((time_reg[5] & 0x80) >> 7) * 100);
 }
 
 /**
- * @brief	ds3231 store temperature in register 11h (MSB) 12h (LSB)
+ * @brief	read all 19 (BYTE) register (from reg 0x00 to reg 0x12) in one burst and store raw value into ds3231_registers[]
+ * @return	true if the transaction succeeded, ds3231_registers[] is left untouched otherwise
+ */
+bool ds3231ReadAllRegisters()
+{
+	uint8_t snapshot[DS3231_REG_COUNT];
+
+	if(!ds3231ReadBurst(ADDRESS_SEC, snapshot, DS3231_REG_COUNT))
+	{
+		return false;
+	}
+	memcpy(ds3231_registers, snapshot, DS3231_REG_COUNT);
+	return true;
+}
+
+/**
+ * @brief	read consecutive registers in one transaction, raw register value (not converted from BCD)
+ * @param	address first register address
+ * @param	*data buffer at least size bytes long
+ * @param	size number of registers to read
+ * @return	true if the transaction succeeded
+ */
+bool ds3231ReadBurst(uint8_t address, uint8_t *data, uint8_t size)
+{
+	return i2cBusMemRead(DS3231_ADDRESS, address, data, size) == HAL_OK;
+}
+
+/**
+ * @brief	ds3231 store temperature in register 11h (MSB) 12h (LSB), both are read in one burst so they can not tear
  * @return	FLOAT temperature
  */
 float ds3231ReadTemp()
 {
-	float temperature = 0.0;
-	uint8_t upper_byte_reg, lower_byte_reg;
-
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, TEMP_MSB, I2C_MEMADD_SIZE_8BIT, &upper_byte_reg, 1, 10);
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, TEMP_LSB, I2C_MEMADD_SIZE_8BIT, &lower_byte_reg, 1, 10);
+	uint8_t temp_reg[2];
 
-	if((upper_byte_reg & 0x80) == 0) // Positive temp
+	if(!ds3231ReadBurst(TEMP_MSB, temp_reg, 2))
 	{
-		temperature = upper_byte_reg + ((lower_byte_reg >> 6) * 0.25);
+		return 0.0;
 	}
-	else
+	return ds3231DecodeTemp(temp_reg[0], temp_reg[1]) * 0.25;
+}
+
+/**
+ * @brief	convert temperature register pair to fixed point
+ * @param	msb_reg value of register 11h (two's complement integer part)
+ * @param	lsb_reg value of register 12h (bit 7:6 fraction part)
+ * @return	temperature in quarter degree Celsius (e.g. 101 = 25.25 C)
+ */
+int16_t ds3231DecodeTemp(uint8_t msb_reg, uint8_t lsb_reg)
+{
+	return (int16_t)((int8_t)msb_reg * 4) + (lsb_reg >> 6);
+}
+
+/**
+ * @brief	force a temperature conversion by setting CONV bit in control register
+ * @note	caller should check BSY bit is cleared before, CONV bit is cleared by ds3231 when conversion is done
+ * @return	true if the control register is written successfully
+ */
+bool ds3231StartConversion()
+{
+	uint8_t control_reg;
+	if(i2cBusMemRead(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1) != HAL_OK)
 	{
-		temperature = -((~upper_byte_reg + 0x01) + ((lower_byte_reg >> 6) * 0.25));
+		return false;
 	}
-	return temperature;
+	control_reg |= (1 << DS3231_CONV);
+	return i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1) == HAL_OK;
 }
 
 /*
@@ -153,7 +256,7 @@ void ds3231SetMin(uint8_t minute)
 void ds3231SetHour(uint8_t hour)
 {
 	uint8_t hour_reg = DEC2BCD(hour) & 0x3f; // remove 2 MSB bit avoid write into bit 12/24 mode
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ADDRESS_HOUR, I2C_MEMADD_SIZE_8BIT, &hour_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ADDRESS_HOUR, &hour_reg, 1);
 }
 void ds3231SetDay(uint8_t day)
 {
@@ -166,20 +269,20 @@ void ds3231SetDate(uint8_t date)
 void ds3231SetMonth(uint8_t month)
 {
 	uint8_t century;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ADDRESS_MONTH, I2C_MEMADD_SIZE_8BIT, &century, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ADDRESS_MONTH, &century, 1);
 	century &= 0x80;
 	uint8_t month_reg = (DEC2BCD(month) & 0x1f) | century; /* not interfere with century bit */
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ADDRESS_MONTH, I2C_MEMADD_SIZE_8BIT, &month_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ADDRESS_MONTH, &month_reg, 1);
 }
 void ds3231SetYear(uint16_t year)
 {
 	uint8_t year_reg = DEC2BCD(year % 100);
 	uint8_t century = (year / 100) % 20;
 	uint8_t month_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ADDRESS_MONTH, I2C_MEMADD_SIZE_8BIT, &month_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ADDRESS_MONTH, &month_reg, 1);
 	month_reg = ((month_reg & 0x1f) | (century << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ADDRESS_MONTH, I2C_MEMADD_SIZE_8BIT, &month_reg, 1, 10);
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ADDRESS_YEAR, I2C_MEMADD_SIZE_8BIT, &year_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ADDRESS_MONTH, &month_reg, 1);
+	i2cBusMemWrite(DS3231_ADDRESS, ADDRESS_YEAR, &year_reg, 1);
 }
 
 /**
@@ -189,16 +292,16 @@ void ds3231SetYear(uint16_t year)
 void ds3231EnableA1(DS3231_State enable)
 {
 	uint8_t control_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_CONTROL, I2C_MEMADD_SIZE_8BIT, &control_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1);
 	control_reg = ((control_reg & 0xfe) | ((enable & 0x01) << DS3231_A1IE));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, DS3231_REG_CONTROL, I2C_MEMADD_SIZE_8BIT, &control_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1);
 }
 void ds3231EnableA2(DS3231_State enable)
 {
 	uint8_t control_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_CONTROL, I2C_MEMADD_SIZE_8BIT, &control_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1);
 	control_reg = ((control_reg & 0xfd) | ((enable & 0x01) << DS3231_A2IE));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, DS3231_REG_CONTROL, I2C_MEMADD_SIZE_8BIT, &control_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_CONTROL, &control_reg, 1);
 }
 
 /**
@@ -209,21 +312,21 @@ void ds3231SetModeA1(DS3231_Alarm1Mode alarmMode)
 {
 	uint8_t temp_reg;
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_SEC, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_SEC, &temp_reg, 1);
 	temp_reg = ((temp_reg & 0x7f) | (((alarmMode >> 0) & 0x01) << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_SEC, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_SEC, &temp_reg, 1);
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_MIN, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_MIN, &temp_reg, 1);
 	temp_reg = ((temp_reg & 0x7f) | (((alarmMode >> 1) & 0x01) << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_MIN, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_MIN, &temp_reg, 1);
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_HOUR, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_HOUR, &temp_reg, 1);
 	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 2) & 0x01) << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_HOUR, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_HOUR, &temp_reg, 1);
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_DATE, &temp_reg, 1);
 	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 3) & 0x01) << 7) | (alarmMode & 0x40));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_DATE, &temp_reg, 1);
 }
 
 /**
@@ -234,17 +337,17 @@ void ds3231SetModeA2(DS3231_Alarm2Mode alarmMode)
 {
 	uint8_t temp_reg;
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_MIN, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_MIN, &temp_reg, 1);
 	temp_reg = ((temp_reg & 0x7f) | (((alarmMode >> 0) & 0x01) << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_MIN, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_MIN, &temp_reg, 1);
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_HOUR, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
-	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 2) & 0x01) << 7));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_HOUR, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_HOUR, &temp_reg, 1);
+	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 1) & 0x01) << 7));
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_HOUR, &temp_reg, 1);
 
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
-	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 3) & 0x01) << 7) | (alarmMode & 0x40));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &temp_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_DATE, &temp_reg, 1);
+	temp_reg = ((temp_reg & 0x3f) | (((alarmMode >> 2) & 0x01) << 7) | (alarmMode & 0x40));
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_DATE, &temp_reg, 1);
 }
 
 /*
@@ -254,37 +357,37 @@ void ds3231SetModeA2(DS3231_Alarm2Mode alarmMode)
 void ds3231SetSecA1(uint8_t second)
 {
 	uint8_t a1_sec_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_SEC, I2C_MEMADD_SIZE_8BIT, &a1_sec_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_SEC, &a1_sec_reg, 1);
 	a1_sec_reg = ((DEC2BCD(second) & 0x7f) | (a1_sec_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_SEC, I2C_MEMADD_SIZE_8BIT, &a1_sec_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_SEC, &a1_sec_reg, 1);
 }
 void ds3231SetMinA1(uint8_t minute)
 {
 	uint8_t a1_min_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_MIN, I2C_MEMADD_SIZE_8BIT, &a1_min_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_MIN, &a1_min_reg, 1);
 	a1_min_reg = ((DEC2BCD(minute) & 0x7f) | (a1_min_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_MIN, I2C_MEMADD_SIZE_8BIT, &a1_min_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_MIN, &a1_min_reg, 1);
 }
 void ds3231SetHourA1(uint8_t hour)
 {
 	uint8_t a1_hour_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_HOUR, I2C_MEMADD_SIZE_8BIT, &a1_hour_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_HOUR, &a1_hour_reg, 1);
 	a1_hour_reg = ((DEC2BCD(hour) & 0x3f) | (a1_hour_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_HOUR, I2C_MEMADD_SIZE_8BIT, &a1_hour_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_HOUR, &a1_hour_reg, 1);
 }
 void ds3231SetDayA1(uint8_t day)
 {
 	uint8_t a1_day_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &a1_day_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_DATE, &a1_day_reg, 1);
 	a1_day_reg = ((DEC2BCD(day) & 0x3f) | 0x40 | (a1_day_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &a1_day_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_DATE, &a1_day_reg, 1);
 }
 void ds3231SetDateA1(uint8_t date)
 {
 	uint8_t a1_date_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &a1_date_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM1_DATE, &a1_date_reg, 1);
 	a1_date_reg = (DEC2BCD(date) & 0x3f) | (a1_date_reg & 0x80);
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM1_DATE, I2C_MEMADD_SIZE_8BIT, &a1_date_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM1_DATE, &a1_date_reg, 1);
 }
 
 /*
@@ -294,30 +397,30 @@ void ds3231SetDateA1(uint8_t date)
 void ds3231SetMinA2(uint8_t minute)
 {
 	uint8_t a2_min_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_MIN, I2C_MEMADD_SIZE_8BIT, &a2_min_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_MIN, &a2_min_reg, 1);
 	a2_min_reg = ((DEC2BCD(minute) & 0x7f) | (a2_min_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_MIN, I2C_MEMADD_SIZE_8BIT, &a2_min_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_MIN, &a2_min_reg, 1);
 }
 void ds3231SetHourA2(uint8_t hour)
 {
 	uint8_t a2_hour_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_HOUR, I2C_MEMADD_SIZE_8BIT, &a2_hour_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_HOUR, &a2_hour_reg, 1);
 	a2_hour_reg = ((DEC2BCD(hour) & 0x3f) | (a2_hour_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_HOUR, I2C_MEMADD_SIZE_8BIT, &a2_hour_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_HOUR, &a2_hour_reg, 1);
 }
 void ds3231SetDayA2(uint8_t day)
 {
 	uint8_t a2_day_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &a2_day_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_DATE, &a2_day_reg, 1);
 	a2_day_reg = ((DEC2BCD(day) & 0x3f) | 0x40 | (a2_day_reg & 0x80));
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &a2_day_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_DATE, &a2_day_reg, 1);
 }
 void ds3231SetDateA2(uint8_t date)
 {
 	uint8_t a2_date_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &a2_date_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, ALARM2_DATE, &a2_date_reg, 1);
 	a2_date_reg = (DEC2BCD(date) & 0x3f) | (a2_date_reg & 0x80);
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, ALARM2_DATE, I2C_MEMADD_SIZE_8BIT, &a2_date_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, ALARM2_DATE, &a2_date_reg, 1);
 }
 
 
@@ -327,41 +430,38 @@ void ds3231SetDateA2(uint8_t date)
 void ds3231ClearFlagA1()
 {
 	uint8_t status_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, DS3231_REG_STATUS, &status_reg, 1);
 	status_reg = status_reg & 0xfe;
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_STATUS, &status_reg, 1);
 	return;
 }
 void ds3231ClearFlagA2()
 {
 	uint8_t status_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
+	i2cBusMemRead(DS3231_ADDRESS, DS3231_REG_STATUS, &status_reg, 1);
 	status_reg = status_reg & 0xfd;
-	HAL_I2C_Mem_Write(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
+	i2cBusMemWrite(DS3231_ADDRESS, DS3231_REG_STATUS, &status_reg, 1);
 	return;
 }
 
 /**
- *	@brief get ds3231 flag bit, and clear flag and return true if flag triggered
+ *	@brief get alarm flag collected by ds3231Poll() and consume it, no bus transaction
+ *	@retval true if alarm triggered since the last call
  */
 bool ds3231GetFlagA1()
 {
-	uint8_t status_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
-	if((status_reg >> DS3231_A1F) & 0x01)
+	if(ds3231_alarm_events & DS3231_EVENT_A1)
 	{
-		ds3231ClearFlagA1();
+		ds3231_alarm_events &= ~DS3231_EVENT_A1;
 		return true;
 	}
 	return false;
 }
 bool ds3231GetFlagA2()
 {
-	uint8_t status_reg;
-	HAL_I2C_Mem_Read(&hi2c1, DS3231_ADDRESS, DS3231_REG_STATUS, I2C_MEMADD_SIZE_8BIT, &status_reg, 1, 10);
-	if((status_reg >> DS3231_A2F) & 0x01)
+	if(ds3231_alarm_events & DS3231_EVENT_A2)
 	{
-		ds3231ClearFlagA2();
+		ds3231_alarm_events &= ~DS3231_EVENT_A2;
 		return true;
 	}
 	return false;
@@ -0,0 +1,398 @@
+/*
+ * ds3231Sim.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "ds3231Sim.h"
+#include "utils.h"
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initDS3231Sim(void);
+
+void ds3231SimSetSpeed(uint32_t factor);
+void ds3231SimAdvance(uint32_t elapsed_ms);
+void ds3231SimTickSecond(void);
+void ds3231SimSetTemp(int16_t quarter_degree);
+
+bool ds3231SimMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+bool ds3231SimMemWrite(uint16_t dev_address, uint16_t mem_address, const uint8_t *data, uint16_t size);
+bool ds3231SimIsDeviceReady(uint16_t dev_address);
+
+uint32_t ds3231SimGetTransactions(void);
+void ds3231SimResetStats(void);
+
+static uint8_t ds3231SimHourTo24(uint8_t hour_reg);
+static uint8_t ds3231SimIncHour(uint8_t hour_reg);
+static uint8_t ds3231SimDaysInMonth(uint8_t month, uint8_t year);
+static bool ds3231SimMatchA1(void);
+static bool ds3231SimMatchA2(void);
+
+/* Variables */
+uint8_t ds3231_sim_registers[DS3231_REG_COUNT];
+DS3231_Sim_Stats ds3231_sim_stats;
+
+static uint32_t sim_speed = 1;
+static uint32_t sim_sub_second_ms = 0; // simulated ms since the last second tick
+static uint32_t sim_conv_remaining_ms = 0;
+static int16_t sim_temperature = DS3231_SIM_TEMP_DEFAULT;
+
+/* Functions */
+/**
+ * @brief	power on state of ds3231: 00:00:00 Sunday 01/01/00, OSF set, 1Hz square wave disabled by INTCN
+ */
+void initDS3231Sim()
+{
+	memset(ds3231_sim_registers, 0, DS3231_REG_COUNT);
+	ds3231_sim_registers[ADDRESS_DAY] = 0x01;
+	ds3231_sim_registers[ADDRESS_DATE] = 0x01;
+	ds3231_sim_registers[ADDRESS_MONTH] = 0x01;
+	ds3231_sim_registers[DS3231_REG_CONTROL] = (1 << DS3231_RS2) | (1 << DS3231_RS1) | (1 << DS3231_INTCN);
+	ds3231_sim_registers[DS3231_REG_STATUS] = (1 << DS3231_OSF) | (1 << DS3231_EN32KHZ);
+
+	sim_speed = 1;
+	sim_sub_second_ms = 0;
+	sim_conv_remaining_ms = 0;
+	ds3231SimSetTemp(DS3231_SIM_TEMP_DEFAULT);
+	ds3231SimResetStats();
+}
+
+/**
+ * @brief	fast forward knob, simulated time runs factor times faster than the time passed to ds3231SimAdvance
+ */
+void ds3231SimSetSpeed(uint32_t factor)
+{
+	sim_speed = (factor == 0) ? 1 : factor;
+}
+
+/**
+ * @brief	advance simulated time
+ * @param	elapsed_ms real time elapsed, multiplied by the speed factor
+ */
+void ds3231SimAdvance(uint32_t elapsed_ms)
+{
+	uint32_t sim_ms = elapsed_ms * sim_speed;
+
+	if(sim_conv_remaining_ms != 0)
+	{
+		if(sim_ms >= sim_conv_remaining_ms)
+		{
+			sim_conv_remaining_ms = 0;
+			ds3231_sim_registers[DS3231_REG_CONTROL] &= ~(1 << DS3231_CONV);
+			ds3231_sim_registers[DS3231_REG_STATUS] &= ~(1 << DS3231_BSY);
+			ds3231SimSetTemp(sim_temperature);
+		}
+		else
+		{
+			sim_conv_remaining_ms -= sim_ms;
+		}
+	}
+
+	sim_sub_second_ms += sim_ms;
+	while(sim_sub_second_ms >= 1000)
+	{
+		sim_sub_second_ms -= 1000;
+		ds3231SimTickSecond();
+	}
+}
+
+/**
+ * @brief	one step of the countdown chain: BCD carry through seconds to years, century toggle and alarm matching
+ */
+void ds3231SimTickSecond()
+{
+	uint8_t *reg = ds3231_sim_registers;
+	uint8_t second = BCD2DEC(reg[ADDRESS_SEC] & 0x7f) + 1;
+
+	if(second == 60)
+	{
+		reg[ADDRESS_SEC] = 0x00;
+		uint8_t minute = BCD2DEC(reg[ADDRESS_MIN] & 0x7f) + 1;
+		if(minute == 60)
+		{
+			reg[ADDRESS_MIN] = 0x00;
+			reg[ADDRESS_HOUR] = ds3231SimIncHour(reg[ADDRESS_HOUR]);
+			if(ds3231SimHourTo24(reg[ADDRESS_HOUR]) == 0)
+			{
+				// midnight: day of week, date, month, year
+				reg[ADDRESS_DAY] = (reg[ADDRESS_DAY] & 0x07) % 7 + 1;
+
+				uint8_t year = BCD2DEC(reg[ADDRESS_YEAR]);
+				uint8_t month = BCD2DEC(reg[ADDRESS_MONTH] & 0x1f);
+				uint8_t date = BCD2DEC(reg[ADDRESS_DATE] & 0x3f) + 1;
+				if(date > ds3231SimDaysInMonth(month, year))
+				{
+					date = 1;
+					month += 1;
+					if(month > 12)
+					{
+						month = 1;
+						year = (year + 1) % 100;
+						if(year == 0)
+						{
+							reg[ADDRESS_MONTH] ^= 0x80; // century bit toggles when year overflows 99 -> 00
+						}
+						reg[ADDRESS_YEAR] = DEC2BCD(year);
+					}
+					reg[ADDRESS_MONTH] = (reg[ADDRESS_MONTH] & 0x80) | DEC2BCD(month);
+				}
+				reg[ADDRESS_DATE] = DEC2BCD(date);
+			}
+		}
+		else
+		{
+			reg[ADDRESS_MIN] = DEC2BCD(minute);
+		}
+	}
+	else
+	{
+		reg[ADDRESS_SEC] = DEC2BCD(second);
+	}
+
+	if(ds3231SimMatchA1())
+	{
+		reg[DS3231_REG_STATUS] |= (1 << DS3231_A1F);
+	}
+	if(reg[ADDRESS_SEC] == 0x00 && ds3231SimMatchA2())
+	{
+		reg[DS3231_REG_STATUS] |= (1 << DS3231_A2F); // alarm 2 is checked once per minute
+	}
+}
+
+/**
+ * @brief	set temperature returned by the next conversion, registers are updated immediately when idle
+ */
+void ds3231SimSetTemp(int16_t quarter_degree)
+{
+	sim_temperature = quarter_degree;
+	if(sim_conv_remaining_ms == 0)
+	{
+		ds3231_sim_registers[TEMP_MSB] = (uint8_t)(int8_t)(quarter_degree >> 2);
+		ds3231_sim_registers[TEMP_LSB] = (uint8_t)((quarter_degree & 0x03) << 6);
+	}
+}
+
+/**
+ * @brief	convert hour register in 12h (bit 6 set, bit 5 PM) or 24h format to 0..23
+ */
+static uint8_t ds3231SimHourTo24(uint8_t hour_reg)
+{
+	if(hour_reg & 0x40)
+	{
+		uint8_t hour = BCD2DEC(hour_reg & 0x1f) % 12;
+		return (hour_reg & 0x20) ? hour + 12 : hour;
+	}
+	return BCD2DEC(hour_reg & 0x3f);
+}
+
+/**
+ * @brief	increase hour register by one hour keeping its 12/24h format
+ */
+static uint8_t ds3231SimIncHour(uint8_t hour_reg)
+{
+	if(hour_reg & 0x40)
+	{
+		uint8_t hour = BCD2DEC(hour_reg & 0x1f);
+		uint8_t pm = hour_reg & 0x20;
+		if(hour == 11)
+		{
+			pm ^= 0x20; // 11:59 AM -> 12:00 PM, 11:59 PM -> 12:00 AM
+		}
+		hour = (hour == 12) ? 1 : hour + 1;
+		return 0x40 | pm | DEC2BCD(hour);
+	}
+	return DEC2BCD((BCD2DEC(hour_reg & 0x3f) + 1) % 24);
+}
+
+/**
+ * @brief	ds3231 leap year rule: every year divisible by 4 (valid up to 2100)
+ */
+static uint8_t ds3231SimDaysInMonth(uint8_t month, uint8_t year)
+{
+	static const uint8_t days[12] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+	if(month < 1 || month > 12)
+	{
+		return 31;
+	}
+	return days[month - 1] + ((month == 2 && (year % 4) == 0) ? 1 : 0);
+}
+
+/**
+ * @brief	alarm 1 matches when every field whose mask bit (A1M1..A1M4) is cleared equals the time
+ */
+static bool ds3231SimMatchA1()
+{
+	const uint8_t *reg = ds3231_sim_registers;
+
+	if(!(reg[ALARM1_SEC] & 0x80) && (reg[ALARM1_SEC] & 0x7f) != reg[ADDRESS_SEC])
+	{
+		return false;
+	}
+	if(!(reg[ALARM1_MIN] & 0x80) && (reg[ALARM1_MIN] & 0x7f) != reg[ADDRESS_MIN])
+	{
+		return false;
+	}
+	if(!(reg[ALARM1_HOUR] & 0x80) && ds3231SimHourTo24(reg[ALARM1_HOUR] & 0x7f) != ds3231SimHourTo24(reg[ADDRESS_HOUR]))
+	{
+		return false;
+	}
+	if(!(reg[ALARM1_DATE] & 0x80))
+	{
+		if(reg[ALARM1_DATE] & 0x40)
+		{
+			return (reg[ALARM1_DATE] & 0x0f) == reg[ADDRESS_DAY];
+		}
+		return (reg[ALARM1_DATE] & 0x3f) == reg[ADDRESS_DATE];
+	}
+	return true;
+}
+
+/**
+ * @brief	alarm 2 matches at second 00 when every field whose mask bit (A2M2..A2M4) is cleared equals the time
+ */
+static bool ds3231SimMatchA2()
+{
+	const uint8_t *reg = ds3231_sim_registers;
+
+	if(!(reg[ALARM2_MIN] & 0x80) && (reg[ALARM2_MIN] & 0x7f) != reg[ADDRESS_MIN])
+	{
+		return false;
+	}
+	if(!(reg[ALARM2_HOUR] & 0x80) && ds3231SimHourTo24(reg[ALARM2_HOUR] & 0x7f) != ds3231SimHourTo24(reg[ADDRESS_HOUR]))
+	{
+		return false;
+	}
+	if(!(reg[ALARM2_DATE] & 0x80))
+	{
+		if(reg[ALARM2_DATE] & 0x40)
+		{
+			return (reg[ALARM2_DATE] & 0x0f) == reg[ADDRESS_DAY];
+		}
+		return (reg[ALARM2_DATE] & 0x3f) == reg[ADDRESS_DATE];
+	}
+	return true;
+}
+
+/**
+ * @brief	burst read, register pointer wraps from 12h to 00h like the real device
+ * @retval	false (NACK) if dev_address is not ds3231
+ */
+bool ds3231SimMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size)
+{
+	ds3231_sim_stats.reads++;
+	if(dev_address != DS3231_SIM_ADDRESS || mem_address >= DS3231_REG_COUNT)
+	{
+		ds3231_sim_stats.nacks++;
+		return false;
+	}
+	for(uint16_t i = 0; i < size; i++)
+	{
+		data[i] = ds3231_sim_registers[(mem_address + i) % DS3231_REG_COUNT];
+	}
+	ds3231_sim_stats.bytes += size;
+	return true;
+}
+
+/**
+ * @brief	burst write with register side effects:
+ * 			- writing seconds resets the sub second countdown
+ * 			- OSF, A2F and A1F can only be cleared, BSY and temperature are read only
+ * 			- setting CONV starts a temperature conversion (BSY set until it is done)
+ * @retval	false (NACK) if dev_address is not ds3231
+ */
+bool ds3231SimMemWrite(uint16_t dev_address, uint16_t mem_address, const uint8_t *data, uint16_t size)
+{
+	ds3231_sim_stats.writes++;
+	if(dev_address != DS3231_SIM_ADDRESS || mem_address >= DS3231_REG_COUNT)
+	{
+		ds3231_sim_stats.nacks++;
+		return false;
+	}
+	for(uint16_t i = 0; i < size; i++)
+	{
+		uint8_t address = (mem_address + i) % DS3231_REG_COUNT;
+		uint8_t value = data[i];
+
+		switch (address)
+		{
+			case ADDRESS_SEC:
+			{
+				sim_sub_second_ms = 0;
+				ds3231_sim_registers[address] = value & 0x7f;
+				break;
+			}
+			case DS3231_REG_CONTROL:
+			{
+				if((value & (1 << DS3231_CONV)) && sim_conv_remaining_ms == 0)
+				{
+					sim_conv_remaining_ms = DS3231_SIM_CONV_MS;
+					ds3231_sim_registers[DS3231_REG_STATUS] |= (1 << DS3231_BSY);
+				}
+				else if(sim_conv_remaining_ms != 0)
+				{
+					value |= (1 << DS3231_CONV); // CONV stays set until the conversion is done
+				}
+				ds3231_sim_registers[address] = value;
+				break;
+			}
+			case DS3231_REG_STATUS:
+			{
+				uint8_t clear_only = (1 << DS3231_OSF) | (1 << DS3231_A2F) | (1 << DS3231_A1F);
+				uint8_t status = ds3231_sim_registers[address];
+				status &= (value | ~clear_only);
+				status = (status & ~(1 << DS3231_EN32KHZ)) | (value & (1 << DS3231_EN32KHZ));
+				ds3231_sim_registers[address] = status;
+				break;
+			}
+			case TEMP_MSB:
+			case TEMP_LSB:
+			{
+				break;
+			}
+			default:
+			{
+				ds3231_sim_registers[address] = value;
+				break;
+			}
+		}
+	}
+	ds3231_sim_stats.bytes += size;
+	return true;
+}
+
+/**
+ * @retval	true if dev_address is ds3231
+ */
+bool ds3231SimIsDeviceReady(uint16_t dev_address)
+{
+	ds3231_sim_stats.probes++;
+	if(dev_address != DS3231_SIM_ADDRESS)
+	{
+		ds3231_sim_stats.nacks++;
+		return false;
+	}
+	return true;
+}
+
+/**
+ * @retval	number of bus transactions since the last ds3231SimResetStats()
+ */
+uint32_t ds3231SimGetTransactions()
+{
+	return ds3231_sim_stats.reads + ds3231_sim_stats.writes + ds3231_sim_stats.probes;
+}
+
+void ds3231SimResetStats()
+{
+	memset(&ds3231_sim_stats, 0, sizeof(ds3231_sim_stats));
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,156 @@
+/*
+ * epoch.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "epoch.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+int32_t epochDaysFromCivil(int32_t year, uint8_t month, uint8_t date);
+void epochCivilFromDays(int32_t days, uint16_t *year, uint8_t *month, uint8_t *date);
+uint8_t epochWeekday(int32_t days);
+
+bool epochIsLeapYear(uint16_t year);
+uint8_t epochDaysInMonth(uint8_t month, uint16_t year);
+
+Epoch epochFromTime(const Time *pTime);
+void epochToTime(Epoch epoch, Time *pTime);
+
+Epoch epochAddMonths(Epoch epoch, int32_t months);
+Epoch epochClamp(Epoch epoch);
+
+/* Functions */
+/**
+ * @brief	number of days since 1970-01-01 of a civil date, constant time (no loop over years or months)
+ * @note	year starts in March internally so the leap day is the last day of the year
+ * @param	year, month (1-12), date (1-31)
+ */
+int32_t epochDaysFromCivil(int32_t year, uint8_t month, uint8_t date)
+{
+	year -= (month <= 2);
+	int32_t era = (year >= 0 ? year : year - 399) / 400;
+	uint32_t year_of_era = (uint32_t)(year - era * 400);											// [0, 399]
+	uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + date - 1;			// [0, 365]
+	uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;	// [0, 146096]
+	return era * 146097 + (int32_t)day_of_era - 719468;
+}
+
+/**
+ * @brief	civil date of a number of days since 1970-01-01, inverse of epochDaysFromCivil
+ */
+void epochCivilFromDays(int32_t days, uint16_t *year, uint8_t *month, uint8_t *date)
+{
+	days += 719468;
+	int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+	uint32_t day_of_era = (uint32_t)(days - era * 146097);
+	uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+	uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	uint32_t month_index = (5 * day_of_year + 2) / 153;	// March = 0
+
+	*date = day_of_year - (153 * month_index + 2) / 5 + 1;
+	*month = month_index < 10 ? month_index + 3 : month_index - 9;
+	*year = year_of_era + era * 400 + (*month <= 2);
+}
+
+/**
+ * @brief	day of week of a number of days since 1970-01-01 (a Thursday)
+ * @return	1 = Sunday ... 7 = Saturday, same as ds3231 day register used by this project
+ */
+uint8_t epochWeekday(int32_t days)
+{
+	return (days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6) + 1;
+}
+
+bool epochIsLeapYear(uint16_t year)
+{
+	return (year % 4 == 0 && year % 100 != 0) || (year % 400 == 0);
+}
+
+/**
+ * @brief	number of days in month without lookup: odd months up to July and even months from August have 31 days
+ */
+uint8_t epochDaysInMonth(uint8_t month, uint16_t year)
+{
+	if(month == 2)
+	{
+		return 28 + epochIsLeapYear(year);
+	}
+	return 30 + ((month + (month >> 3)) & 0x01);
+}
+
+/**
+ * @brief	convert Time struct to epoch, Time.day (day of week) is ignored
+ */
+Epoch epochFromTime(const Time *pTime)
+{
+	return (Epoch)epochDaysFromCivil(pTime->year, pTime->month, pTime->date) * EPOCH_SECONDS_PER_DAY
+			+ pTime->hour * EPOCH_SECONDS_PER_HOUR + pTime->minute * EPOCH_SECONDS_PER_MINUTE + pTime->second;
+}
+
+/**
+ * @brief	convert epoch to Time struct, Time.day (day of week) is derived from the date
+ * @note	Time.alarm_on is left untouched
+ */
+void epochToTime(Epoch epoch, Time *pTime)
+{
+	int32_t days = (int32_t)(epoch / EPOCH_SECONDS_PER_DAY);
+	int32_t second_of_day = (int32_t)(epoch - (Epoch)days * EPOCH_SECONDS_PER_DAY);
+
+	if(second_of_day < 0)
+	{
+		days -= 1;
+		second_of_day += EPOCH_SECONDS_PER_DAY;
+	}
+
+	epochCivilFromDays(days, &pTime->year, &pTime->month, &pTime->date);
+	pTime->day = epochWeekday(days);
+	pTime->hour = second_of_day / EPOCH_SECONDS_PER_HOUR;
+	pTime->minute = (second_of_day / EPOCH_SECONDS_PER_MINUTE) % 60;
+	pTime->second = second_of_day % 60;
+}
+
+/**
+ * @brief	move epoch by a number of months keeping time of day, date is clamped to the end of the target month
+ */
+Epoch epochAddMonths(Epoch epoch, int32_t months)
+{
+	Time time;
+	epochToTime(epoch, &time);
+
+	int32_t month_index = (int32_t)time.year * 12 + (time.month - 1) + months;
+	time.year = month_index / 12;
+	time.month = month_index % 12 + 1;
+
+	uint8_t days_in_month = epochDaysInMonth(time.month, time.year);
+	if(time.date > days_in_month)
+	{
+		time.date = days_in_month;
+	}
+	return epochFromTime(&time);
+}
+
+/**
+ * @brief	keep epoch inside the range where ds3231 and this calendar agree, EPOCH_MIN to EPOCH_MAX
+ */
+Epoch epochClamp(Epoch epoch)
+{
+	if(epoch < EPOCH_MIN)
+	{
+		return EPOCH_MIN;
+	}
+	if(epoch > EPOCH_MAX)
+	{
+		return EPOCH_MAX;
+	}
+	return epoch;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,151 @@
+/*
+ * event.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "event.h"
+#include "main.h"
+#include "sTimer.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initEvent(void);
+
+bool eventPost(Event_Source source, Event_Type type, uint32_t data);
+void eventPostTimer(void *context);
+bool eventGet(Event *pEvent);
+bool eventPending(void);
+
+void eventReport(void);
+
+/* Variables */
+Event_Queue event_queues[EVENT_SOURCE_COUNT];
+
+/* Functions */
+void initEvent()
+{
+	for(uint8_t source = 0; source < EVENT_SOURCE_COUNT; source++)
+	{
+		event_queues[source].head = 0;
+		event_queues[source].tail = 0;
+		event_queues[source].high_water = 0;
+		event_queues[source].posted = 0;
+		event_queues[source].drops = 0;
+	}
+}
+
+/**
+ * @brief	push an event, lock free as long as only the ISR of this source calls it
+ * @retval	false if the queue is full, the event is counted as dropped
+ */
+bool eventPost(Event_Source source, Event_Type type, uint32_t data)
+{
+	Event_Queue *pQueue = &event_queues[source];
+	uint16_t head = pQueue->head;
+	uint16_t count = head - pQueue->tail;
+
+	if(count >= EVENT_QUEUE_SIZE)
+	{
+		pQueue->drops++;
+		return false;
+	}
+
+	Event *pEvent = &pQueue->buffer[head & EVENT_QUEUE_MASK];
+	pEvent->type = type;
+	pEvent->data = data;
+	pEvent->timestamp = sTimerGetTick();
+
+	__DMB(); // event must be complete before the consumer can see it
+	pQueue->head = head + 1;
+
+	pQueue->posted++;
+	if(count + 1 > pQueue->high_water)
+	{
+		pQueue->high_water = count + 1;
+	}
+	return true;
+}
+
+/**
+ * @brief	sTimer callback posting a timer event, context is the Event_Type
+ */
+void eventPostTimer(void *context)
+{
+	(void)eventPost(EVENT_SOURCE_TIMER, (Event_Type)(uintptr_t)context, 0);
+}
+
+/**
+ * @brief	pop the oldest pending event of all sources, call from main loop only
+ * @retval	false if every queue is empty
+ */
+bool eventGet(Event *pEvent)
+{
+	Event_Queue *pOldest = NULL;
+
+	for(uint8_t source = 0; source < EVENT_SOURCE_COUNT; source++)
+	{
+		Event_Queue *pQueue = &event_queues[source];
+		if(pQueue->head == pQueue->tail)
+		{
+			continue;
+		}
+
+		if(pOldest == NULL || (int32_t)(pQueue->buffer[pQueue->tail & EVENT_QUEUE_MASK].timestamp
+				- pOldest->buffer[pOldest->tail & EVENT_QUEUE_MASK].timestamp) < 0)
+		{
+			pOldest = pQueue;
+		}
+	}
+
+	if(pOldest == NULL)
+	{
+		return false;
+	}
+
+	__DMB(); // read the event only after seeing the producer's head
+	*pEvent = pOldest->buffer[pOldest->tail & EVENT_QUEUE_MASK];
+	__DMB(); // slot must be read before the producer may reuse it
+	pOldest->tail = pOldest->tail + 1;
+	return true;
+}
+
+/**
+ * @retval	true if any queue holds an event
+ */
+bool eventPending()
+{
+	for(uint8_t source = 0; source < EVENT_SOURCE_COUNT; source++)
+	{
+		if(event_queues[source].head != event_queues[source].tail)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void eventReport()
+{
+	for(uint8_t source = 0; source < EVENT_SOURCE_COUNT; source++)
+	{
+		rs232SendString((void*)"Event q");
+		rs232SendNum(source);
+		rs232SendString((void*)" posted:");
+		rs232SendNum(event_queues[source].posted);
+		rs232SendString((void*)" high:");
+		rs232SendNum(event_queues[source].high_water);
+		rs232SendString((void*)" drop:");
+		rs232SendNum(event_queues[source].drops);
+		rs232SendString((void*)"\r\n");
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,284 @@
+/*
+ * i2cBus.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "i2cBus.h"
+#include "utils.h"
+#include "timebase.h"
+#include "rs232_uart.h"
+#include "trace.h"
+#ifdef DS3231_SIM
+#include "ds3231Sim.h"
+#endif /* DS3231_SIM */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initI2CBus(void);
+
+bool i2cBusIsDeviceReady(uint16_t dev_address);
+HAL_StatusTypeDef i2cBusMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+HAL_StatusTypeDef i2cBusMemWrite(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+
+bool i2cBusRecover(void);
+void i2cBusReport(void);
+
+static HAL_StatusTypeDef i2cBusTransfer(bool is_write, uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size);
+static void i2cBusRecord(HAL_StatusTypeDef status, uint32_t cycles);
+
+/* Variables */
+I2C_Bus_Stats i2c_bus_stats;
+
+/* Functions */
+/**
+ * @brief	init i2c health layer, call after MX_I2C1_Init
+ */
+void initI2CBus()
+{
+	initCycleCounter();
+
+#ifdef DS3231_SIM
+	initDS3231Sim();
+#endif /* DS3231_SIM */
+
+	// a slave may still hold SDA low if the MCU was reset in the middle of a transaction
+	if(HAL_GPIO_ReadPin(I2C_BUS_GPIO_Port, I2C_BUS_SDA_Pin) == GPIO_PIN_RESET
+			|| __HAL_I2C_GET_FLAG(&hi2c1, I2C_FLAG_BUSY))
+	{
+		i2cBusRecover();
+	}
+}
+
+/**
+ * @brief	check device acknowledges its address, the bus is recovered between attempts
+ * @param	dev_address 8 bit device address
+ * @retval	true if device answered within I2C_BUS_MAX_RETRIES retries
+ */
+bool i2cBusIsDeviceReady(uint16_t dev_address)
+{
+	for(uint8_t attempt = 0; attempt <= I2C_BUS_MAX_RETRIES; attempt++)
+	{
+#ifdef DS3231_SIM
+		if(ds3231SimIsDeviceReady(dev_address))
+#else
+		if(HAL_I2C_IsDeviceReady(&hi2c1, dev_address, 3, I2C_BUS_TIMEOUT) == HAL_OK)
+#endif /* DS3231_SIM */
+		{
+			return true;
+		}
+		i2c_bus_stats.retries++;
+		i2cBusRecover();
+	}
+	return false;
+}
+
+/**
+ * @brief	read registers of device with bounded retries, latency and errors are recorded
+ * @param	dev_address 8 bit device address
+ * @param	mem_address first register address (8 bit)
+ * @param	*data buffer to store into
+ * @param	size number of bytes
+ * @retval	status of the last attempt
+ */
+HAL_StatusTypeDef i2cBusMemRead(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size)
+{
+	return i2cBusTransfer(false, dev_address, mem_address, data, size);
+}
+
+/**
+ * @brief	write registers of device with bounded retries, latency and errors are recorded
+ * @param	dev_address 8 bit device address
+ * @param	mem_address first register address (8 bit)
+ * @param	*data bytes to write
+ * @param	size number of bytes
+ * @retval	status of the last attempt
+ */
+HAL_StatusTypeDef i2cBusMemWrite(uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size)
+{
+	return i2cBusTransfer(true, dev_address, mem_address, data, size);
+}
+
+static HAL_StatusTypeDef i2cBusTransfer(bool is_write, uint16_t dev_address, uint16_t mem_address, uint8_t *data, uint16_t size)
+{
+	HAL_StatusTypeDef status = HAL_ERROR;
+
+	TRACE(TRACE_I2C_BEGIN, is_write, (uint32_t)dev_address << 16 | (mem_address & 0xff) << 8 | (size & 0xff));
+	for(uint8_t attempt = 0; attempt <= I2C_BUS_MAX_RETRIES; attempt++)
+	{
+		uint32_t start = getCycleCounter();
+#ifdef DS3231_SIM
+		if(is_write)
+		{
+			status = ds3231SimMemWrite(dev_address, mem_address, data, size) ? HAL_OK : HAL_ERROR;
+		}
+		else
+		{
+			status = ds3231SimMemRead(dev_address, mem_address, data, size) ? HAL_OK : HAL_ERROR;
+		}
+#else
+		if(is_write)
+		{
+			status = HAL_I2C_Mem_Write(&hi2c1, dev_address, mem_address, I2C_MEMADD_SIZE_8BIT, data, size, I2C_BUS_TIMEOUT);
+		}
+		else
+		{
+			status = HAL_I2C_Mem_Read(&hi2c1, dev_address, mem_address, I2C_MEMADD_SIZE_8BIT, data, size, I2C_BUS_TIMEOUT);
+		}
+#endif /* DS3231_SIM */
+		i2cBusRecord(status, getCycleCounter() - start);
+
+		if(status == HAL_OK)
+		{
+			break;
+		}
+		if(attempt < I2C_BUS_MAX_RETRIES)
+		{
+			i2c_bus_stats.retries++;
+			// a NACK leaves the bus idle, anything else may have left it stuck
+			if(status != HAL_ERROR || (HAL_I2C_GetError(&hi2c1) & ~HAL_I2C_ERROR_AF) != 0)
+			{
+				i2cBusRecover();
+			}
+		}
+	}
+	TRACE(TRACE_I2C_END, status, 0);
+	return status;
+}
+
+/**
+ * @brief	update statistic with result of one attempt
+ * @param	status HAL status of attempt
+ * @param	cycles duration of attempt in core clock cycles
+ */
+static void i2cBusRecord(HAL_StatusTypeDef status, uint32_t cycles)
+{
+	uint32_t us = cycles / (SystemCoreClock / 1000000);
+
+	i2c_bus_stats.transactions++;
+	if(us > i2c_bus_stats.max_us)
+	{
+		i2c_bus_stats.max_us = us;
+	}
+
+	i2c_bus_stats.histogram[histogramBucket(us, I2C_BUS_HISTOGRAM_SHIFT, I2C_BUS_HISTOGRAM_SIZE)]++;
+
+	switch (status)
+	{
+		case HAL_OK:
+		{
+			break;
+		}
+		case HAL_BUSY:
+		{
+			i2c_bus_stats.errors++;
+			i2c_bus_stats.busy++;
+			break;
+		}
+		case HAL_TIMEOUT:
+		{
+			i2c_bus_stats.errors++;
+			i2c_bus_stats.timeouts++;
+			break;
+		}
+		default:
+		{
+			i2c_bus_stats.errors++;
+			if(HAL_I2C_GetError(&hi2c1) & HAL_I2C_ERROR_AF)
+			{
+				i2c_bus_stats.nacks++;
+			}
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	release a stuck bus: clock SCL until the slave frees SDA, send STOP and re-init I2C1
+ * @retval	true if SDA is released
+ */
+bool i2cBusRecover()
+{
+	i2c_bus_stats.recoveries++;
+
+#ifdef DS3231_SIM
+	return true; // the model never holds the bus
+#else
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	GPIO_PinState sda;
+
+	HAL_I2C_DeInit(&hi2c1);
+
+	// drive both lines as open-drain GPIO
+	HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SCL_Pin | I2C_BUS_SDA_Pin, GPIO_PIN_SET);
+	GPIO_InitStruct.Pin = I2C_BUS_SCL_Pin | I2C_BUS_SDA_Pin;
+	GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_OD;
+	GPIO_InitStruct.Pull = GPIO_NOPULL;
+	GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+	HAL_GPIO_Init(I2C_BUS_GPIO_Port, &GPIO_InitStruct);
+	timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+
+	for(uint8_t clock = 0; clock < I2C_BUS_RECOVERY_CLOCKS; clock++)
+	{
+		if(HAL_GPIO_ReadPin(I2C_BUS_GPIO_Port, I2C_BUS_SDA_Pin) == GPIO_PIN_SET)
+		{
+			break;
+		}
+		HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_RESET);
+		timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+		HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_SET);
+		timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+	}
+
+	// STOP condition: SDA rises while SCL is high
+	HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_RESET);
+	timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+	HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SDA_Pin, GPIO_PIN_RESET);
+	timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+	HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SCL_Pin, GPIO_PIN_SET);
+	timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+	HAL_GPIO_WritePin(I2C_BUS_GPIO_Port, I2C_BUS_SDA_Pin, GPIO_PIN_SET);
+	timebaseDelayUs(I2C_BUS_HALF_PERIOD_US);
+
+	sda = HAL_GPIO_ReadPin(I2C_BUS_GPIO_Port, I2C_BUS_SDA_Pin);
+
+	// MspInit gives the pins back to I2C1, HAL_I2C_Init also resets the peripheral
+	MX_I2C1_Init();
+
+	return sda == GPIO_PIN_SET;
+#endif /* DS3231_SIM */
+}
+
+/**
+ * @brief	send statistic over rs232
+ */
+void i2cBusReport()
+{
+	rs232SendString((void*)"I2C tx:");
+	rs232SendNum(i2c_bus_stats.transactions);
+	rs232SendString((void*)" err:");
+	rs232SendNum(i2c_bus_stats.errors);
+	rs232SendString((void*)" nack:");
+	rs232SendNum(i2c_bus_stats.nacks);
+	rs232SendString((void*)" timeout:");
+	rs232SendNum(i2c_bus_stats.timeouts);
+	rs232SendString((void*)" busy:");
+	rs232SendNum(i2c_bus_stats.busy);
+	rs232SendString((void*)" retry:");
+	rs232SendNum(i2c_bus_stats.retries);
+	rs232SendString((void*)" recover:");
+	rs232SendNum(i2c_bus_stats.recoveries);
+	rs232SendString((void*)" max:");
+	rs232SendNum(i2c_bus_stats.max_us);
+	rs232SendString((void*)"us\r\n");
+
+	histogramReport(i2c_bus_stats.histogram, I2C_BUS_HISTOGRAM_SHIFT, I2C_BUS_HISTOGRAM_SIZE);
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
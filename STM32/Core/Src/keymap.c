@@ -0,0 +1,97 @@
+/*
+ * keymap.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "keymap.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initKeymap(void);
+
+bool keymapLoad(const Keymap_Entry *pEntries, uint16_t count);
+uint8_t keymapLookup(uint8_t mode, const Button_Event *pEvent);
+
+/* Variables */
+static uint8_t keymap_table[KEYMAP_MODES][BUTTON_COUNT][BUTTON_EVENT_TYPE_COUNT];	// 640 bytes
+
+/* Functions */
+/**
+ * @brief	start with every event unmapped
+ */
+void initKeymap()
+{
+	for(uint8_t mode = 0; mode < KEYMAP_MODES; mode++)
+	{
+		for(uint8_t key = 0; key < BUTTON_COUNT; key++)
+		{
+			for(uint8_t type = 0; type < BUTTON_EVENT_TYPE_COUNT; type++)
+			{
+				keymap_table[mode][key][type] = KEYMAP_NONE;
+			}
+		}
+	}
+}
+
+/**
+ * @brief	replace the keymap with a list of entries
+ * @retval	false if an entry is out of range or maps an event that an earlier entry already maps,
+ * 			such entries are skipped and the others are loaded
+ */
+bool keymapLoad(const Keymap_Entry *pEntries, uint16_t count)
+{
+	bool valid = true;
+
+	initKeymap();
+
+	for(uint16_t i = 0; i < count; i++)
+	{
+		const Keymap_Entry *pEntry = &pEntries[i];
+
+		if(pEntry->mode >= KEYMAP_MODES || pEntry->key >= BUTTON_COUNT || pEntry->action == KEYMAP_NONE)
+		{
+			valid = false;
+			continue;
+		}
+
+		for(uint8_t type = BUTTON_EVENT_NONE + 1; type < BUTTON_EVENT_TYPE_COUNT; type++)
+		{
+			if((pEntry->events & KEYMAP_ON(type)) == 0)
+			{
+				continue;
+			}
+
+			uint8_t *pAction = &keymap_table[pEntry->mode][pEntry->key][type];
+			if(*pAction != KEYMAP_NONE)
+			{
+				valid = false;
+				continue;
+			}
+			*pAction = pEntry->action;
+		}
+	}
+
+	return valid;
+}
+
+/**
+ * @brief	action of a button event in a mode, O(1)
+ * @retval	KEYMAP_NONE if the event is not mapped in this mode or there is no event
+ */
+uint8_t keymapLookup(uint8_t mode, const Button_Event *pEvent)
+{
+	if(mode >= KEYMAP_MODES || pEvent->key >= BUTTON_COUNT || pEvent->type >= BUTTON_EVENT_TYPE_COUNT)
+	{
+		return KEYMAP_NONE;
+	}
+	return keymap_table[mode][pEvent->key][pEvent->type];
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
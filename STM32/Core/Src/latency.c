@@ -0,0 +1,149 @@
+/*
+ * latency.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "latency.h"
+#include "timebase.h"
+#include "rs232_uart.h"
+#include "utils.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initLatency(void);
+
+void latencyDispatch(uint8_t mode, const Button_Event *pEvent);
+void latencyComplete(void);
+void latencyReset(void);
+
+void latencyReport(void);
+
+/* Variables */
+Latency_Stats latency_stats[KEYMAP_MODES];
+
+/* the sample waiting for its update to complete */
+static bool latency_pending = false;
+static uint8_t latency_mode = 0;
+static uint32_t latency_edge = 0;
+static uint32_t latency_dispatch = 0;
+
+/* Functions */
+void initLatency()
+{
+	latencyReset();
+}
+
+/**
+ * @brief	start a sample, call when a key event is mapped to an action. replaces a sample that did not complete
+ * @param	mode the event was dispatched in
+ */
+void latencyDispatch(uint8_t mode, const Button_Event *pEvent)
+{
+	if(mode >= KEYMAP_MODES)
+	{
+		return;
+	}
+
+	latency_dispatch = timebaseGetUs32();
+	latency_edge = pEvent->time_us;
+	latency_mode = mode;
+	latency_pending = true;
+}
+
+/**
+ * @brief	end the pending sample, call when the display shows the result of the action. does nothing without one
+ */
+void latencyComplete()
+{
+	if(!latency_pending)
+	{
+		return;
+	}
+	latency_pending = false;
+
+	uint32_t now = timebaseGetUs32();
+	uint32_t wait = latency_dispatch - latency_edge;
+	uint32_t ui = now - latency_dispatch;
+	uint32_t total = now - latency_edge;
+	Latency_Stats *pStats = &latency_stats[latency_mode];
+
+	pStats->count++;
+	pStats->wait_total += wait;
+	pStats->ui_total += ui;
+	if(wait > pStats->wait_max)
+	{
+		pStats->wait_max = wait;
+	}
+	if(ui > pStats->ui_max)
+	{
+		pStats->ui_max = ui;
+	}
+	if(total > pStats->total_max)
+	{
+		pStats->total_max = total;
+	}
+
+	pStats->histogram[histogramBucket(total, LATENCY_HISTOGRAM_SHIFT, LATENCY_HISTOGRAM_SIZE)]++;
+}
+
+void latencyReset()
+{
+	latency_pending = false;
+	for(uint8_t mode = 0; mode < KEYMAP_MODES; mode++)
+	{
+		Latency_Stats *pStats = &latency_stats[mode];
+		pStats->count = 0;
+		pStats->wait_max = 0;
+		pStats->wait_total = 0;
+		pStats->ui_max = 0;
+		pStats->ui_total = 0;
+		pStats->total_max = 0;
+		for(uint8_t bucket = 0; bucket < LATENCY_HISTOGRAM_SIZE; bucket++)
+		{
+			pStats->histogram[bucket] = 0;
+		}
+	}
+}
+
+/**
+ * @brief	send every mode with samples and its non empty histogram buckets over rs232
+ */
+void latencyReport()
+{
+	for(uint8_t mode = 0; mode < KEYMAP_MODES; mode++)
+	{
+		Latency_Stats *pStats = &latency_stats[mode];
+
+		if(pStats->count == 0)
+		{
+			continue;
+		}
+
+		rs232SendString((void*)"mode ");
+		rs232SendNum(mode);
+		rs232SendString((void*)" n:");
+		rs232SendNum(pStats->count);
+		rs232SendString((void*)" wait avg:");
+		rs232SendNum((uint32_t)(pStats->wait_total / pStats->count));
+		rs232SendString((void*)" max:");
+		rs232SendNum(pStats->wait_max);
+		rs232SendString((void*)"us ui avg:");
+		rs232SendNum((uint32_t)(pStats->ui_total / pStats->count));
+		rs232SendString((void*)" max:");
+		rs232SendNum(pStats->ui_max);
+		rs232SendString((void*)"us total max:");
+		rs232SendNum(pStats->total_max);
+		rs232SendString((void*)"us\r\n");
+
+		histogramReport(pStats->histogram, LATENCY_HISTOGRAM_SHIFT, LATENCY_HISTOGRAM_SIZE);
+	}
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
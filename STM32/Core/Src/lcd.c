@@ -8,6 +8,7 @@
 #include "lcdFont.h"
 #include "lcd.h"
 #include "fsmc.h"
+#include "trace.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -99,6 +100,7 @@ uint16_t lcdReadPoint(uint16_t x, uint16_t y)
 void lcdClear(uint16_t color)
 {
 	uint16_t i, j;
+	TRACE(TRACE_LCD_BEGIN, TRACE_LCD_CLEAR, (uint32_t)lcddev.width * lcddev.height);
 	lcdSetAddress(0, 0, lcddev.width - 1, lcddev.height - 1);
 	for (i = 0; i < lcddev.width; i++)
 	{
@@ -107,6 +109,29 @@ void lcdClear(uint16_t color)
 			LCD_WR_DATA(color);
 		}
 	}
+	TRACE(TRACE_LCD_END, TRACE_LCD_CLEAR, 0);
+}
+
+/**
+ * @brief  Fill the next band of rows with a color, lets a caller split a full clear into short steps
+ * @param  color Color to fill the screen
+ * @param  rows Number of rows filled per call
+ * @retval true once the whole screen is filled, the next call starts over from the top
+ */
+bool lcdClearStep(uint16_t color, uint16_t rows)
+{
+	static uint16_t row = 0;
+	uint16_t end = (row + rows < lcddev.height) ? row + rows : lcddev.height;
+
+	lcdFill(0, row, lcddev.width, end, color);
+	row = end;
+
+	if(row >= lcddev.height)
+	{
+		row = 0;
+		return true;
+	}
+	return false;
 }
 
 /**
@@ -122,6 +147,7 @@ void lcdFill(uint16_t xsta, uint16_t ysta, uint16_t xend, uint16_t yend,
 		uint16_t color)
 {
 	uint16_t i, j;
+	TRACE(TRACE_LCD_BEGIN, TRACE_LCD_FILL, (uint32_t)(xend - xsta) * (yend - ysta));
 	lcdSetAddress(xsta, ysta, xend - 1, yend - 1);
 	for (i = ysta; i < yend; i++)
 	{
@@ -130,6 +156,7 @@ void lcdFill(uint16_t xsta, uint16_t ysta, uint16_t xend, uint16_t yend,
 			LCD_WR_DATA(color);
 		}
 	}
+	TRACE(TRACE_LCD_END, TRACE_LCD_FILL, 0);
 }
 
 /**
@@ -229,6 +256,7 @@ void lcdShowChar(uint16_t x, uint16_t y, uint8_t character, uint16_t fc, uint16_
 	sizex = sizey / 2;
 	TypefaceNum = (sizex / 8 + ((sizex % 8) ? 1 : 0)) * sizey;
 	character = character - ' ';
+	TRACE(TRACE_LCD_BEGIN, TRACE_LCD_CHAR, (uint32_t)sizex * sizey);
 	lcdSetAddress(x, y, x + sizex - 1, y + sizey - 1);
 	for (i = 0; i < TypefaceNum; i++)
 	{
@@ -241,7 +269,10 @@ void lcdShowChar(uint16_t x, uint16_t y, uint8_t character, uint16_t fc, uint16_
 		else if (sizey == 32)
 			temp = ascii_3216[character][i];
 		else
+		{
+			TRACE(TRACE_LCD_END, TRACE_LCD_CHAR, 0);
 			return;
+		}
 		for (t = 0; t < 8; t++)
 		{
 			if (!mode) {
@@ -270,6 +301,7 @@ void lcdShowChar(uint16_t x, uint16_t y, uint8_t character, uint16_t fc, uint16_
 			}
 		}
 	}
+	TRACE(TRACE_LCD_END, TRACE_LCD_CHAR, 0);
 }
 
 uint32_t mypow(uint8_t m, uint8_t n)
@@ -362,6 +394,7 @@ void lcdShowPicture(uint16_t x, uint16_t y, uint16_t length, uint16_t width,
 	uint8_t picH, picL;
 	uint16_t i, j;
 	uint32_t k = 0;
+	TRACE(TRACE_LCD_BEGIN, TRACE_LCD_PICTURE, (uint32_t)length * width);
 	lcdSetAddress(x, y, x + length - 1, y + width - 1);
 	for (i = 0; i < length; i++)
 	{
@@ -373,6 +406,7 @@ void lcdShowPicture(uint16_t x, uint16_t y, uint16_t length, uint16_t width,
 			k++;
 		}
 	}
+	TRACE(TRACE_LCD_END, TRACE_LCD_PICTURE, 0);
 }
 
 void lcdSetDirection(uint8_t dir)
@@ -530,6 +564,7 @@ void lcdDrawCircle(int xc, int yc, uint16_t c, int r, int fill)
 
 	d = 3 - 2 * r;
 
+	TRACE(TRACE_LCD_BEGIN, TRACE_LCD_CIRCLE, 0);
 	if (fill) {
 		while (x <= y)
 		{
@@ -565,6 +600,7 @@ void lcdDrawCircle(int xc, int yc, uint16_t c, int r, int fill)
 			x++;
 		}
 	}
+	TRACE(TRACE_LCD_END, TRACE_LCD_CIRCLE, 0);
 }
 
 /**
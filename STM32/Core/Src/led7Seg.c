@@ -6,7 +6,10 @@
  */
 
 #include "led7Seg.h"
-#include "spi.h"
+#include "spiBus.h"
+#include "utils.h"
+#include "rs232_uart.h"
+#include "sTimer.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -23,12 +26,134 @@ void led7SegDisplay();
 void led7SegDebugTurnOff(uint8_t index);
 void led7SegDebugTurnOn(uint8_t index);
 
+void led7SegBlink(uint8_t digits, uint8_t leds);
+void led7SegSetBlinkTiming(uint16_t period_ms, uint16_t on_ms);
+
+uint8_t led7SegGlyph(char c);
+void led7SegShowSegments(uint32_t digits);
+void led7SegShowText(const char *text);
+void led7SegShowTime(uint8_t high, uint8_t low);
+void led7SegShowCountdown(uint32_t seconds);
+void led7SegShowTemperature(int16_t temperature);
+
+void led7SegScroll(const char *text, uint16_t step_ms);
+void led7SegScrollStop(void);
+bool led7SegIsScrolling(void);
+
+void led7SegSetBrightness(uint8_t position, uint8_t level);
+uint8_t led7SegGetBrightness(uint8_t position);
+
+void led7SegReport(void);
+
+static uint16_t led7SegFrame(uint8_t index);
+static uint16_t led7SegBlank(uint16_t frame);
+static void led7SegStore(uint32_t digits, bool colon);
+static void led7SegScrollStep(void *context);
+static void led7SegUpdate(void);
+
+/* Private define */
+#define LED7SEG_GLYPH(a, b, c, d, e, f, g)	((a) << 7 | (b) << 6 | (c) << 5 | (d) << 4 | (e) << 3 | (f) << 2 | (g) << 1)
+#define LED7SEG_FONT_FIRST	' '
+#define LED7SEG_FONT_SIZE	96		// ' ' to DEL
+
 /* Variables */
-static uint8_t led_7seg[4] = { 0, 1, 2, 3 };
-static uint8_t led_7seg_map_of_output[10] = { 0x03, 0x9f, 0x25, 0x0d, 0x99, 0x49, 0x41,
-		0x1f, 0x01, 0x09 };
+/* active low segment bytes of the four digits, digit 0 in the low byte. written with one store
+ * so the refresh never shows a half updated display */
+static volatile uint32_t led_7seg_digits = 0x03020100;
+
+/* glyphs by ASCII code, lit segments set, characters without a sensible shape are blank.
+ * some letters only have one case or share the shape of a digit (O 0, S 5, Z 2) */
+static const uint8_t led_7seg_font[LED7SEG_FONT_SIZE] = {
+	['-' - ' '] = LED7SEG_GLYPH(0, 0, 0, 0, 0, 0, 1),
+	['_' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 0, 0, 0),
+	['=' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 0, 0, 1),
+	['.' - ' '] = LED7SEG_SEG_DP,
+	['\'' - ' '] = LED7SEG_GLYPH(0, 1, 0, 0, 0, 0, 0),
+	['"' - ' '] = LED7SEG_GLYPH(0, 1, 0, 0, 0, 1, 0),
+	['*' - ' '] = LED7SEG_GLYPH(1, 1, 0, 0, 0, 1, 1),	// degree
+	['?' - ' '] = LED7SEG_GLYPH(1, 1, 0, 0, 1, 0, 1),
+	['[' - ' '] = LED7SEG_GLYPH(1, 0, 0, 1, 1, 1, 0),
+	[']' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 0, 0, 0),
+	['0' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 1, 1, 0),
+	['1' - ' '] = LED7SEG_GLYPH(0, 1, 1, 0, 0, 0, 0),
+	['2' - ' '] = LED7SEG_GLYPH(1, 1, 0, 1, 1, 0, 1),
+	['3' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 0, 0, 1),
+	['4' - ' '] = LED7SEG_GLYPH(0, 1, 1, 0, 0, 1, 1),
+	['5' - ' '] = LED7SEG_GLYPH(1, 0, 1, 1, 0, 1, 1),
+	['6' - ' '] = LED7SEG_GLYPH(1, 0, 1, 1, 1, 1, 1),
+	['7' - ' '] = LED7SEG_GLYPH(1, 1, 1, 0, 0, 0, 0),
+	['8' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 1, 1, 1),
+	['9' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 0, 1, 1),
+	['A' - ' '] = LED7SEG_GLYPH(1, 1, 1, 0, 1, 1, 1),
+	['B' - ' '] = LED7SEG_GLYPH(0, 0, 1, 1, 1, 1, 1),
+	['C' - ' '] = LED7SEG_GLYPH(1, 0, 0, 1, 1, 1, 0),
+	['D' - ' '] = LED7SEG_GLYPH(0, 1, 1, 1, 1, 0, 1),
+	['E' - ' '] = LED7SEG_GLYPH(1, 0, 0, 1, 1, 1, 1),
+	['F' - ' '] = LED7SEG_GLYPH(1, 0, 0, 0, 1, 1, 1),
+	['G' - ' '] = LED7SEG_GLYPH(1, 0, 1, 1, 1, 1, 0),
+	['H' - ' '] = LED7SEG_GLYPH(0, 1, 1, 0, 1, 1, 1),
+	['I' - ' '] = LED7SEG_GLYPH(0, 0, 0, 0, 1, 1, 0),
+	['J' - ' '] = LED7SEG_GLYPH(0, 1, 1, 1, 1, 0, 0),
+	['K' - ' '] = LED7SEG_GLYPH(1, 0, 1, 0, 1, 1, 1),
+	['L' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 1, 1, 0),
+	['M' - ' '] = LED7SEG_GLYPH(1, 0, 1, 0, 1, 0, 0),
+	['N' - ' '] = LED7SEG_GLYPH(1, 1, 1, 0, 1, 1, 0),
+	['O' - ' '] = LED7SEG_GLYPH(1, 1, 1, 1, 1, 1, 0),
+	['P' - ' '] = LED7SEG_GLYPH(1, 1, 0, 0, 1, 1, 1),
+	['Q' - ' '] = LED7SEG_GLYPH(1, 1, 1, 0, 0, 1, 1),
+	['R' - ' '] = LED7SEG_GLYPH(0, 0, 0, 0, 1, 0, 1),
+	['S' - ' '] = LED7SEG_GLYPH(1, 0, 1, 1, 0, 1, 1),
+	['T' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 1, 1, 1),
+	['U' - ' '] = LED7SEG_GLYPH(0, 1, 1, 1, 1, 1, 0),
+	['V' - ' '] = LED7SEG_GLYPH(0, 0, 1, 1, 1, 0, 0),
+	['W' - ' '] = LED7SEG_GLYPH(0, 1, 0, 1, 0, 1, 0),
+	['X' - ' '] = LED7SEG_GLYPH(0, 1, 1, 0, 1, 1, 1),
+	['Y' - ' '] = LED7SEG_GLYPH(0, 1, 1, 1, 0, 1, 1),
+	['Z' - ' '] = LED7SEG_GLYPH(1, 1, 0, 1, 1, 0, 1),
+	['b' - ' '] = LED7SEG_GLYPH(0, 0, 1, 1, 1, 1, 1),
+	['c' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 1, 0, 1),
+	['d' - ' '] = LED7SEG_GLYPH(0, 1, 1, 1, 1, 0, 1),
+	['h' - ' '] = LED7SEG_GLYPH(0, 0, 1, 0, 1, 1, 1),
+	['i' - ' '] = LED7SEG_GLYPH(0, 0, 1, 0, 0, 0, 0),
+	['n' - ' '] = LED7SEG_GLYPH(0, 0, 1, 0, 1, 0, 1),
+	['o' - ' '] = LED7SEG_GLYPH(0, 0, 1, 1, 1, 0, 1),
+	['r' - ' '] = LED7SEG_GLYPH(0, 0, 0, 0, 1, 0, 1),
+	['t' - ' '] = LED7SEG_GLYPH(0, 0, 0, 1, 1, 1, 1),
+	['u' - ' '] = LED7SEG_GLYPH(0, 0, 1, 1, 1, 0, 0),
+};
+static const uint8_t led_7seg_enable[LED7SEG_DIGITS] = { 0xb0, 0xd0, 0xe0, 0x70 }; // bits 4-7, the cleared one selects the digit
 static uint16_t led_7seg_index = 0;
-static uint16_t spi_buffer = 0xffff;
+static uint16_t spi_buffer = 0xffff; // low nibble: colon and debug leds
+
+/* scrolling message, stepped by an sTimer callback in interrupt context */
+static STimer led_7seg_scroll_timer;
+static const char *led_7seg_scroll_text = NULL;
+static uint16_t led_7seg_scroll_length = 0;
+static uint16_t led_7seg_scroll_offset = 0;
+
+/* blink state, the clock runs in the 1ms interrupt */
+static volatile uint8_t led_7seg_blink_digits = 0;
+static volatile uint8_t led_7seg_blink_leds = 0;
+static volatile uint16_t led_7seg_blink_ms = 0;
+static volatile bool led_7seg_blink_hidden = false;
+static uint16_t led_7seg_blink_period = LED7SEG_BLINK_PERIOD_MS;
+static uint16_t led_7seg_blink_on = LED7SEG_BLINK_ON_MS;
+
+static uint8_t led_7seg_brightness[LED7SEG_DIGITS] = { LED7SEG_BRIGHTNESS_MAX, LED7SEG_BRIGHTNESS_MAX,
+		LED7SEG_BRIGHTNESS_MAX, LED7SEG_BRIGHTNESS_MAX };
+
+/* cost in core cycles: the refresh in the 1ms interrupt and the DMA frame rebuild */
+static uint32_t led_7seg_isr_count = 0;
+static uint32_t led_7seg_isr_max = 0;
+static uint64_t led_7seg_isr_total = 0;
+static uint32_t led_7seg_update_count = 0;
+static uint32_t led_7seg_update_max = 0;
+static uint64_t led_7seg_update_total = 0;
+
+#ifdef LED7SEG_USE_DMA
+/* LED7SEG_BCM_SLOTS frames per digit, read by DMA, bytes swapped for 16 bit SPI frames */
+static volatile uint16_t led_7seg_frames[LED7SEG_DIGITS * LED7SEG_BCM_SLOTS];
+#endif /* LED7SEG_USE_DMA */
 
 /* Functions */
 /**
@@ -38,63 +163,463 @@ static uint16_t spi_buffer = 0xffff;
  */
 void initLed7Seg()
 {
-	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 1);
+	initCycleCounter();
+#ifdef LED7SEG_USE_DMA
+	led7SegUpdate();
+	spiBusStartStream(led_7seg_frames, LED7SEG_DIGITS * LED7SEG_BCM_SLOTS, LED7SEG_SLOT_US);
+#else
+	(void)spiBusTransfer(led7SegFrame(0), NULL);
+#endif /* LED7SEG_USE_DMA */
 }
 
 /**
- * @brief	Scan led 7 segment
+ * @brief	Scan led 7 segment, the same transfer samples the buttons
  * @param	None
  * @note	Call in 1ms interrupt (Be called in default in Timer 4 callback function)
  * @retval 	None
  */
 void led7SegDisplay()
 {
-	spi_buffer &= 0x00ff;
-	spi_buffer |= led_7seg[led_7seg_index] << 8;
+	uint32_t start = getCycleCounter();
+
+	if (led_7seg_blink_digits | led_7seg_blink_leds)
+	{
+		if (++led_7seg_blink_ms >= led_7seg_blink_period)
+		{
+			led_7seg_blink_ms = 0;
+		}
+
+		bool hidden = led_7seg_blink_ms >= led_7seg_blink_on;
+		if (hidden != led_7seg_blink_hidden)
+		{
+			led_7seg_blink_hidden = hidden;
+			led7SegUpdate();
+		}
+	}
+
+#ifndef LED7SEG_USE_DMA
+	uint16_t frame = led7SegFrame(led_7seg_index);
+	if (led_7seg_brightness[led_7seg_index] == 0)
+	{
+		frame = led7SegBlank(frame);
+	}
+
+	led_7seg_index = (led_7seg_index + 1) % LED7SEG_DIGITS;
+
+	(void)spiBusTransfer(frame, NULL);
+#endif /* LED7SEG_USE_DMA */
+
+	uint32_t cycles = getCycleCounter() - start;
+	led_7seg_isr_count++;
+	led_7seg_isr_total += cycles;
+	if (cycles > led_7seg_isr_max)
+	{
+		led_7seg_isr_max = cycles;
+	}
+}
+
+/**
+ * @brief	word shifted out while digit index is lit: segments in the high byte, enables, colon and debug leds in the low byte.
+ * 			in the hidden blink phase blinking digits are blank, blinking debug leds off and a blinking colon off
+ */
+static uint16_t led7SegFrame(uint8_t index)
+{
+	uint8_t segments = led_7seg_digits >> (index * 8);
+	uint8_t leds = spi_buffer & 0x000f;
 
-	switch (led_7seg_index) {
-	case 0:
-		spi_buffer |= 0x00b0;
-		spi_buffer &= 0xffbf;
-		break;
-	case 1:
-		spi_buffer |= 0x00d0;
-		spi_buffer &= 0xffdf;
-		break;
-	case 2:
-		spi_buffer |= 0x00e0;
-		spi_buffer &= 0xffef;
-		break;
-	case 3:
-		spi_buffer |= 0x0070;
-		spi_buffer &= 0xff7f;
-		break;
-	default:
-		break;
+	if (led_7seg_blink_hidden)
+	{
+		if (led_7seg_blink_digits & (1 << index))
+		{
+			segments = 0xff;
+		}
+		leds = (leds & ~(led_7seg_blink_leds & LED7SEG_BLINK_DEBUG)) | (led_7seg_blink_leds & LED7SEG_BLINK_COLON);
 	}
+	return (segments << 8) | led_7seg_enable[index] | leds;
+}
 
-	led_7seg_index = (led_7seg_index + 1) % 4;
+/**
+ * @brief	the same frame with every digit off, the colon and debug leds are not multiplexed and keep their state
+ */
+static uint16_t led7SegBlank(uint16_t frame)
+{
+	return frame | 0xfff0;
+}
+
+/**
+ * @brief	apply a change of the display state, only the DMA frame buffer has to follow
+ * 			slot s of a digit shows brightness bit n for 2^n - 1 <= s < 2^(n + 1) - 1, so bit n owns 2^n slots
+ * @note	called from main and from the blink clock in the 1ms interrupt
+ */
+static void led7SegUpdate()
+{
+#ifdef LED7SEG_USE_DMA
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+	uint32_t start = getCycleCounter();
 
-	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 0);
-	HAL_SPI_Transmit(&hspi1, (void*) &spi_buffer, 2, 1);
-	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 1);
+	volatile uint16_t *pFrame = led_7seg_frames;
+	for (uint8_t index = 0; index < LED7SEG_DIGITS; index++)
+	{
+		uint16_t frame = led7SegFrame(index);
+		uint16_t on = (uint16_t)__REV16(frame);
+		uint16_t off = (uint16_t)__REV16(led7SegBlank(frame));
+		uint8_t level = led_7seg_brightness[index];
+
+		for (uint8_t slot = 1; slot <= LED7SEG_BCM_SLOTS; slot++)
+		{
+			uint8_t weight = 0x80000000 >> __CLZ(slot); // highest power of 2 <= slot
+			*pFrame++ = (level & weight) ? on : off;
+		}
+	}
+
+	uint32_t cycles = getCycleCounter() - start;
+	led_7seg_update_count++;
+	led_7seg_update_total += cycles;
+	if (cycles > led_7seg_update_max)
+	{
+		led_7seg_update_max = cycles;
+	}
+	__set_PRIMASK(primask);
+#endif /* LED7SEG_USE_DMA */
+}
+
+/**
+ * @brief	blink part of the display, the refresh hides them for the second part of every blink period
+ * @param	digits bit n blinks digit n, 0 for none
+ * @param	leds LED7SEG_BLINK_DEBUG and/or LED7SEG_BLINK_COLON, 0 for none
+ * @note	the phase restarts in the shown part, call again after a value changed to keep it visible
+ */
+void led7SegBlink(uint8_t digits, uint8_t leds)
+{
+	led_7seg_blink_digits = 0; // stop the clock while the phase is reset
+	led_7seg_blink_leds = 0;
+	led_7seg_blink_ms = 0;
+	led_7seg_blink_hidden = false;
+	led_7seg_blink_digits = digits;
+	led_7seg_blink_leds = leds;
+	led7SegUpdate();
+}
+
+/**
+ * @brief	set blink period and the part of it the blinking items are shown
+ */
+void led7SegSetBlinkTiming(uint16_t period_ms, uint16_t on_ms)
+{
+	if (period_ms > 0 && on_ms <= period_ms)
+	{
+		led_7seg_blink_period = period_ms;
+		led_7seg_blink_on = on_ms;
+	}
+}
+
+/**
+ * @brief	set the brightness of one digit or of all
+ * @param	position digit index, LED7SEG_ALL for every digit
+ * @param	level 0 (off) to LED7SEG_BRIGHTNESS_MAX, larger values are clamped
+ * @note	the frames are only rebuilt if a level changed, cheap to call on every clock tick
+ */
+void led7SegSetBrightness(uint8_t position, uint8_t level)
+{
+	bool changed = false;
+
+	if (level > LED7SEG_BRIGHTNESS_MAX)
+	{
+		level = LED7SEG_BRIGHTNESS_MAX;
+	}
+
+	for (uint8_t index = 0; index < LED7SEG_DIGITS; index++)
+	{
+		if ((position == LED7SEG_ALL || position == index) && led_7seg_brightness[index] != level)
+		{
+			led_7seg_brightness[index] = level;
+			changed = true;
+		}
+	}
+
+	if (changed)
+	{
+		led7SegUpdate();
+	}
+}
+
+uint8_t led7SegGetBrightness(uint8_t position)
+{
+	return (position < LED7SEG_DIGITS) ? led_7seg_brightness[position] : 0;
+}
+
+/**
+ * @brief	send brightness and the cost of driving the display over rs232
+ * 			"isr" is led7SegDisplay in the 1ms interrupt: the blocking SPI transfer without DMA, only the blink clock with it.
+ * 			"rebuild" is the DMA frame rebuild after a change, it runs with interrupts disabled
+ */
+void led7SegReport()
+{
+	rs232SendString((void*)"7seg brightness:");
+	for (uint8_t index = 0; index < LED7SEG_DIGITS; index++)
+	{
+		rs232SendString((void*)" ");
+		rs232SendNum(led_7seg_brightness[index]);
+	}
+#ifdef LED7SEG_USE_DMA
+	rs232SendString((void*)" dma bcm\r\n");
+#else
+	rs232SendString((void*)" isr spi\r\n");
+#endif /* LED7SEG_USE_DMA */
+
+	rs232SendString((void*)"isr calls:");
+	rs232SendNum(led_7seg_isr_count);
+	rs232SendString((void*)" avg:");
+	rs232SendNum((led_7seg_isr_count > 0) ? (uint32_t)(led_7seg_isr_total / led_7seg_isr_count) : 0);
+	rs232SendString((void*)" max:");
+	rs232SendNum(led_7seg_isr_max);
+	rs232SendString((void*)" cycles\r\n");
+
+	rs232SendString((void*)"rebuild count:");
+	rs232SendNum(led_7seg_update_count);
+	rs232SendString((void*)" avg:");
+	rs232SendNum((led_7seg_update_count > 0) ? (uint32_t)(led_7seg_update_total / led_7seg_update_count) : 0);
+	rs232SendString((void*)" max:");
+	rs232SendNum(led_7seg_update_max);
+	rs232SendString((void*)" cycles\r\n");
 }
 
 /**
  * @brief  	Display a digit at a position of led 7-segment
- * @param  	num	Number displayed
+ * @param  	num	Number displayed, 0 to 15 in hex
  * @param  	pos	The position displayed (index from 0)
  * @param  	show_dot Show dot in the led or not
  * @retval 	None
  */
 void led7SegSetDigit(uint8_t num, uint8_t position, uint8_t show_dot)
 {
-	if (num <= 9)
+	if (num <= 0x0f && position < LED7SEG_DIGITS)
 	{
-		led_7seg[position] = led_7seg_map_of_output[num] - show_dot;
+		led7SegScrollStop();
+		uint8_t segments = led7SegGlyph("0123456789AbCdEF"[num]) & ~(show_dot ? LED7SEG_SEG_DP : 0);
+		led_7seg_digits = (led_7seg_digits & ~(0xffUL << (position * 8))) | ((uint32_t)segments << (position * 8));
+		led7SegUpdate();
 	}
 }
 
+/**
+ * @brief	active low segment byte of a character, blank for characters the font does not have
+ */
+uint8_t led7SegGlyph(char c)
+{
+	uint8_t index = (uint8_t)c - LED7SEG_FONT_FIRST;
+
+	if (index >= LED7SEG_FONT_SIZE)
+	{
+		return 0xff;
+	}
+	return (uint8_t)~led_7seg_font[index];
+}
+
+/**
+ * @brief	show four raw active low segment bytes, digit 0 in the low byte. stops a scrolling message
+ */
+void led7SegShowSegments(uint32_t digits)
+{
+	led7SegScrollStop();
+	led_7seg_digits = digits;
+	led7SegUpdate();
+}
+
+/**
+ * @brief	show up to four characters, left aligned. stops a scrolling message
+ * 			a '.' lights the dot of the character before it, a ':' anywhere turns the colon on, else it is off.
+ * 			"12:30", "3.14", "Err"
+ */
+void led7SegShowText(const char *text)
+{
+	uint32_t digits = 0xffffffff;
+	uint8_t position = 0;
+	bool colon = false;
+	bool dot = false;	// the dot of the previous position is free for a '.'
+
+	for (; *text != '\0'; text++)
+	{
+		if (*text == ':')
+		{
+			colon = true;
+		}
+		else if (*text == '.' && dot)
+		{
+			digits &= ~((uint32_t)LED7SEG_SEG_DP << ((position - 1) * 8));
+			dot = false;
+		}
+		else if (position < LED7SEG_DIGITS)
+		{
+			digits &= ~(0xffUL << (position * 8)) | ((uint32_t)led7SegGlyph(*text) << (position * 8));
+			dot = *text != '.';
+			position++;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	led7SegScrollStop();
+	led7SegStore(digits, colon);
+}
+
+/**
+ * @brief	show two 2 digit fields with the colon on, HH:MM with (hour, minute) or MM:SS with (minute, second)
+ */
+void led7SegShowTime(uint8_t high, uint8_t low)
+{
+	char text[6] = { '0' + high / 10 % 10, '0' + high % 10, ':', '0' + low / 10 % 10, '0' + low % 10, '\0' };
+
+	led7SegShowText(text);
+}
+
+/**
+ * @brief	show the time left of a countdown, MM:SS below one hour, HH:MM from there, 99:59 at most
+ */
+void led7SegShowCountdown(uint32_t seconds)
+{
+	if (seconds < 3600)
+	{
+		led7SegShowTime(seconds / 60, seconds % 60);
+	}
+	else if (seconds < 100UL * 3600)
+	{
+		led7SegShowTime(seconds / 3600, seconds / 60 % 60);
+	}
+	else
+	{
+		led7SegShowTime(99, 59);
+	}
+}
+
+/**
+ * @brief	show a temperature right aligned with one decimal and a trailing C: " 9.2C", "23.5C", "-4.7C", "-12C", "105C"
+ * @param	temperature in quarters of a degree, as given by temperatureGetLatest
+ */
+void led7SegShowTemperature(int16_t temperature)
+{
+	char text[8];
+	uint8_t index = 0;
+	uint16_t abs_temp = (temperature < 0) ? -temperature : temperature;
+	uint16_t integer = abs_temp / 4;
+	uint8_t tenth = (abs_temp % 4) * 25 / 10;
+
+	if (temperature < 0)
+	{
+		text[index++] = '-';
+	}
+	else if (integer < 10)
+	{
+		text[index++] = ' ';
+	}
+
+	if ((temperature < 0 && integer >= 10) || integer >= 100)
+	{
+		if (integer >= 100)
+		{
+			text[index++] = '0' + integer / 100 % 10;
+		}
+		text[index++] = '0' + integer / 10 % 10;
+		text[index++] = '0' + integer % 10;
+	}
+	else
+	{
+		if (integer >= 10)
+		{
+			text[index++] = '0' + integer / 10;
+		}
+		text[index++] = '0' + integer % 10;
+		text[index++] = '.';
+		text[index++] = '0' + tenth;
+	}
+	text[index++] = 'C';
+	text[index] = '\0';
+
+	led7SegShowText(text);
+}
+
+/**
+ * @brief	scroll a message from right to left, one character every step_ms, over and over until stopped
+ * 			or replaced by any other led7SegShow call. the colon is off, a '.' takes a position of its own
+ * @param	*text must stay valid while it scrolls, a string literal is fine
+ */
+void led7SegScroll(const char *text, uint16_t step_ms)
+{
+	uint16_t length = 0;
+
+	while (text[length] != '\0')
+	{
+		length++;
+	}
+
+	led7SegScrollStop();
+	led_7seg_scroll_text = text;
+	led_7seg_scroll_length = length;
+	led_7seg_scroll_offset = 0;
+	led7SegScrollStep(NULL);
+	sTimerStart(&led_7seg_scroll_timer, step_ms, step_ms, led7SegScrollStep, NULL);
+}
+
+void led7SegScrollStop()
+{
+	sTimerStop(&led_7seg_scroll_timer);
+	led_7seg_scroll_text = NULL;
+}
+
+bool led7SegIsScrolling()
+{
+	return sTimerIsActive(&led_7seg_scroll_timer);
+}
+
+/**
+ * @brief	show the next window of the scrolling message, the text enters at the right, one blank window between passes
+ * @note	sTimer callback, runs in the 1ms interrupt
+ */
+static void led7SegScrollStep(void *context)
+{
+	(void)context;
+	const char *text = led_7seg_scroll_text;
+	uint32_t digits = 0xffffffff;
+
+	if (text == NULL)
+	{
+		return;
+	}
+
+	led_7seg_scroll_offset++;
+	if (led_7seg_scroll_offset > led_7seg_scroll_length + LED7SEG_DIGITS)
+	{
+		led_7seg_scroll_offset = 1;
+	}
+
+	// the window ends at character offset - 1 of the text, positions before the text are blank
+	for (uint8_t position = 0; position < LED7SEG_DIGITS; position++)
+	{
+		int16_t index = led_7seg_scroll_offset - LED7SEG_DIGITS + position;
+		if (index >= 0 && index < led_7seg_scroll_length)
+		{
+			digits &= ~(0xffUL << (position * 8)) | ((uint32_t)led7SegGlyph(text[index]) << (position * 8));
+		}
+	}
+
+	led7SegStore(digits, false);
+}
+
+/**
+ * @brief	publish a complete display: one store of the four digits, then the colon, then the DMA frames
+ */
+static void led7SegStore(uint32_t digits, bool colon)
+{
+	led_7seg_digits = digits;
+	if (colon)
+		spi_buffer &= ~(1 << 3);
+	else
+		spi_buffer |= (1 << 3);
+	led7SegUpdate();
+}
+
 /**
  * @brief	Control the colon led
  * @param	status Status applied to the colon (1: turn on, 0: turn off)
@@ -105,10 +630,12 @@ void led7SegSetDigit(uint8_t num, uint8_t position, uint8_t show_dot)
  */
 void led7SegSetColon(uint8_t status)
 {
+	led7SegScrollStop();	// the scroll step rewrites the colon from the 1ms interrupt
 	if (status == 1)
 		spi_buffer &= ~(1 << 3);
 	else
 		spi_buffer |= (1 << 3);
+	led7SegUpdate();
 }
 
 /**
@@ -116,7 +643,12 @@ void led7SegSetColon(uint8_t status)
  */
 void led7SegTurnOff(uint8_t position)
 {
-	led_7seg[position] = 0xff;
+	if (position < LED7SEG_DIGITS)
+	{
+		led7SegScrollStop();
+		led_7seg_digits |= 0xffUL << (position * 8);
+		led7SegUpdate();
+	}
 }
 
 /**
@@ -132,7 +664,12 @@ void led7SegDebugTurnOn(uint8_t index)
 {
 	if (index >= 6 && index <= 8)
 	{
+		// a scroll step stores the colon bit of the same word from the 1ms interrupt
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
 		spi_buffer |= 1 << (index - 6);
+		__set_PRIMASK(primask);
+		led7SegUpdate();
 	}
 }
 
@@ -149,7 +686,12 @@ void led7SegDebugTurnOff(uint8_t index)
 {
 	if (index >= 6 && index <= 8)
 	{
+		// a scroll step stores the colon bit of the same word from the 1ms interrupt
+		uint32_t primask = __get_PRIMASK();
+		__disable_irq();
 		spi_buffer &= ~(1 << (index - 6));
+		__set_PRIMASK(primask);
+		led7SegUpdate();
 	}
 }
 
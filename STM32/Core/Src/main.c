@@ -32,6 +32,21 @@
 #include "lcd.h"
 #include "led7Seg.h"
 #include "button.h"
+#include "temperature.h"
+#include "i2cBus.h"
+#include "spiBus.h"
+#include "rs232_uart.h"
+#include "epoch.h"
+#include "alarm.h"
+#include "event.h"
+#include "keymap.h"
+#include "latency.h"
+#include "scheduler.h"
+#include "power.h"
+#include "profiler.h"
+#include "timebase.h"
+#include "deadline.h"
+#include "trace.h"
 #include <math.h>
 #include <string.h>
 #include <stdint.h>
@@ -40,6 +55,12 @@
 
 /* Private typedef -----------------------------------------------------------*/
 /* USER CODE BEGIN PTD */
+typedef struct
+{
+	uint8_t hour;		// from this time of day on
+	uint8_t minute;
+	uint8_t level;		// 7 segment brightness, 0 to LED7SEG_BRIGHTNESS_MAX
+}Brightness_Step;
 
 /* USER CODE END PTD */
 
@@ -47,6 +68,15 @@
 /* USER CODE BEGIN PD */
 #define PI 3.14159265358979323846
 
+#define MONITOR_CHAR_SIZE		16
+#define MONITOR_HEX_X			56
+#define MONITOR_BIT_X			96
+#define MONITOR_BIT_SPACING		16
+#define MONITOR_REFRESH_TICKS	2 // refresh register monitor every 2 x 50ms (10Hz)
+
+#define UI_CLEAR_ROWS			40 // rows cleared per ui task step on a mode change
+#define UI_TICK_MS				50 // period of ui_tick_50ms
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -65,6 +95,7 @@ void SystemClock_Config(void);
 /* USER CODE BEGIN PFP */
 void debugSystem(void);
 void initSystem(void);
+void uartCommand(uint8_t command);
 void displayClock(int x_coor, int y_coor, int radius);
 void displayLocation(int y_coor, char *str, char *GMT_str, uint8_t char_size);
 
@@ -76,20 +107,33 @@ void displayTime(int x_coor, int y_coor, const uint8_t *second, const uint8_t *m
 		uint8_t char_size, uint16_t color_sec, uint16_t color_min, uint16_t color_hour);
 void displayDate(int x_coor, int y_coor, const uint8_t *date, const uint8_t *month, const uint16_t *year,
 		uint8_t char_size, uint16_t color_date, uint16_t color_month, uint16_t color_year);
-void displayTemp(int x_coor, int y_coor, float temperature, uint8_t char_size, uint16_t color_temp);
+void displayTemp(int x_coor, int y_coor, int16_t temperature, uint8_t char_size, uint16_t color_temp);
 void displayDay(int x_coor, int y_coor, const uint8_t *day, uint8_t char_size, uint16_t color_day);
 
 void displayTimeLed7Seg(const uint8_t *second, const uint8_t *minute, const uint8_t *hour);
+void displayRegisterLayout(void);
+void displayRegisterMonitor(bool full_redraw);
+
+Task_Result taskUi(void);
+Task_Result taskEvent(void);
+Task_Result taskInput(void);
+Task_Result taskTemperature(void);
+Task_Result taskPower(void);
+void displayAlarmRepeat(int x_coor, int y_coor, Alarm_Repeat repeat, uint8_t char_size, uint16_t color_repeat);
+void displayAlarmCount(int x_coor, int y_coor, uint8_t char_size);
+void applyBrightnessSchedule(void);
 void setTime(uint8_t *second, uint8_t *minute, uint8_t *hour, uint8_t *day, uint8_t *date, uint8_t *month, uint16_t *year);
 void setAlarm1(uint8_t second, uint8_t minute, uint8_t hour, uint8_t day, uint8_t date);
 void setAlarm2(uint8_t minute, uint8_t hour, uint8_t day, uint8_t date);
 
-void increaseSec(void);
-void decreaseSec(void);
-void increaseMin(void);
-void decreaseMin(void);
-void increaseHour(void);
-void decreaseHour(void);
+bool adjustSetTime(int32_t seconds);
+void adjustSetMonth(int32_t months);
+bool increaseSec(void);
+bool decreaseSec(void);
+bool increaseMin(void);
+bool decreaseMin(void);
+bool increaseHour(void);
+bool decreaseHour(void);
 void increaseDay(void);
 void decreaseDay(void);
 void increaseDate(void);
@@ -98,7 +142,6 @@ void increaseMonth(void);
 void decreaseMonth(void);
 void increaseYear(void);
 void decreaseYear(void);
-int getDaysInMonth(int month, int year);
 
 /* USER CODE END PFP */
 
@@ -113,10 +156,31 @@ enum State
     Mode_config_alarm,
 	Mode_stopwatch,
 	Mode_timers,
-	Mode_monitor_register
+	Mode_monitor_register,
+	Mode_count	// number of modes, not a mode
 };
+_Static_assert(Mode_count <= KEYMAP_MODES, "keymap and latency tables hold KEYMAP_MODES modes");
 enum State current_mode = Mode_init;
 enum State previous_mode = Mode_init;
+enum State traced_mode = Mode_init;
+
+/* what a key does, bound to (mode, key, event) by keymap_panel */
+enum Action
+{
+	Action_none = KEYMAP_NONE,
+	Action_config_time,
+	Action_config_alarm,
+	Action_monitor,
+	Action_dismiss_alarm,
+	Action_next_field,
+	Action_previous_field,
+	Action_increase,
+	Action_decrease,
+	Action_next_repeat,
+	Action_clear_alarms,
+	Action_save,
+	Action_back
+};
 
 enum State_config
 {
@@ -131,6 +195,58 @@ enum State_config
 enum State_config current_mode_config = Mode_config_second;
 enum State_config previous_mode_config = Mode_config_minute;
 
+void displaySetDate(enum State_config field);
+
+STimer timer_50ms;	// posts EVENT_TICK_50MS: ui tick, independent of the button scan rate
+STimer timer_500ms;	// posts EVENT_TICK_500MS: clock refresh and blink
+
+uint8_t task_ui = SCHEDULER_NO_TASK;
+bool ui_tick_50ms = false;		// set by event task
+bool ui_tick_500ms = false;		// set by event task
+bool ui_temp_updated = false;	// set by temperature task
+
+int clock_radius = 100;
+uint8_t monitor_ticks = 0;
+uint8_t temp_ticks = 0;
+uint8_t alarm_field = 0; // 0: hour, 1: minute
+Alarm_Repeat alarm_repeat = ALARM_DAILY;
+
+const Button_Config key_adjust = {0, 600, 400, 100};		// 3, 7: +/-, accelerating repeat while held
+const Button_Config key_field = {0, 1500, 1500, 1500};		// 11, 15: next/previous field every 1.5s while held
+
+/* keys of this panel, the repeat timing of the KEYMAP_DOWN keys is set with buttonConfigure in initSystem */
+const Keymap_Entry keymap_panel[] = {
+	{Mode_word_clock,		12, KEYMAP_PRESS,	Action_config_time},
+	{Mode_word_clock,		13, KEYMAP_PRESS,	Action_config_alarm},
+	{Mode_word_clock,		15, KEYMAP_PRESS,	Action_monitor},
+	{Mode_word_clock,		14, KEYMAP_PRESS,	Action_dismiss_alarm},
+
+	{Mode_config_time,		3,	KEYMAP_DOWN,	Action_increase},
+	{Mode_config_time,		7,	KEYMAP_DOWN,	Action_decrease},
+	{Mode_config_time,		11, KEYMAP_DOWN,	Action_next_field},
+	{Mode_config_time,		15, KEYMAP_DOWN,	Action_previous_field},
+	{Mode_config_time,		12, KEYMAP_PRESS,	Action_save},
+	{Mode_config_time,		14, KEYMAP_PRESS,	Action_back},
+
+	{Mode_config_alarm,		3,	KEYMAP_DOWN,	Action_increase},
+	{Mode_config_alarm,		7,	KEYMAP_DOWN,	Action_decrease},
+	{Mode_config_alarm,		11, KEYMAP_DOWN,	Action_next_field},
+	{Mode_config_alarm,		13, KEYMAP_PRESS,	Action_next_repeat},
+	{Mode_config_alarm,		15, KEYMAP_PRESS,	Action_clear_alarms},
+	{Mode_config_alarm,		12, KEYMAP_PRESS,	Action_save},
+	{Mode_config_alarm,		14, KEYMAP_PRESS,	Action_back},
+
+	{Mode_monitor_register,	14, KEYMAP_PRESS,	Action_back}
+};
+
+/* sorted by time, the last step holds over midnight until the first one */
+const Brightness_Step brightness_schedule[] = {
+	{6, 30, LED7SEG_BRIGHTNESS_MAX},
+	{19, 0, 10},
+	{22, 0, 4},
+	{23, 30, 1}
+};
+
 /* USER CODE END 0 */
 
 /**
@@ -172,10 +288,15 @@ int main(void)
   /* USER CODE BEGIN 2 */
   initSystem();
 
-  sTimer4Set(1000, 50); // interrupt every 50ms
-  sTimer2Set(0, 500); // interrupt every 500ms
+  sTimerStart(&timer_50ms, 0, UI_TICK_MS, eventPostTimer, (void*)EVENT_TICK_50MS);
+  sTimerStart(&timer_500ms, 0, 500, eventPostTimer, (void*)EVENT_TICK_500MS);
 
-  int clock_radius = 100;
+  (void)schedulerAdd("event", taskEvent, TASK_PRIORITY_HIGH, 1, 1);
+  (void)schedulerAdd("input", taskInput, TASK_PRIORITY_HIGH, BUTTON_SCAN_MS, 5);
+  (void)schedulerAdd("temp", taskTemperature, TASK_PRIORITY_NORMAL, 50, 50);
+  task_ui = schedulerAdd("ui", taskUi, TASK_PRIORITY_LOW, 0, 50);
+  (void)schedulerAdd("power", taskPower, TASK_PRIORITY_NORMAL, POWER_WINDOW_MS, POWER_WINDOW_MS);
+  schedulerSetIdleHook(powerIdle);
 
   /* USER CODE END 2 */
 
@@ -183,97 +304,236 @@ int main(void)
   /* USER CODE BEGIN WHILE */
   while (1)
   {
-	  if(sTimer4GetFlag())
-	  {
-		  buttonScan();
-		  led7SegDisplay();
-	  }
-
-	  switch (current_mode)
-	  {
-	  case Mode_init:
-	  {
-		  led7SegSetColon(1);
-		  setTime(&set_time.second, &set_time.minute, &set_time.hour, &set_time.day, &set_time.date, &set_time.month, &set_time.year);
-
-		  current_time.alarm_on = false;
-
-		  current_mode = Mode_config_time;
-
-		  break;
-	  }
-	  case Mode_word_clock:
-	  {
-		  if(previous_mode != current_mode)
-		  {
-			  lcdClear(WHITE);
-			  clock_radius = 100;
-			  displayClock(LCD_WIDTH / 2, 110, clock_radius);
-
-			  (void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &current_time.second, BLUE);
-			  (void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &current_time.second, &current_time.minute, BLACK);
-			  (void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &current_time.minute, &current_time.hour, RED);
-
-			  displayTime(LCD_WIDTH / 2, 240, &current_time.second, &current_time.minute, &current_time.hour, 32, BLACK, BLACK, BLACK);
-			  displayDate(LCD_WIDTH / 2, 240 + 32, &current_time.date, &current_time.month, &current_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-			  displayDay(20, 320 - 10 - 24, &current_time.day, 24, RED);
-
-			  previous_mode = current_mode;
-		  }
-
-		  if(sTimer2GetFlag())
-		  {
-			  debugSystem();
-
-			  ds3231ReadTime();
-
-			  (void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &current_time.second, BLUE);
-			  (void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &current_time.second, &current_time.minute, BLACK);
-			  (void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &current_time.minute, &current_time.hour, RED);
-
-			  displayTime(LCD_WIDTH / 2, 240, &current_time.second, &current_time.minute, &current_time.hour, 32, BLACK, BLACK, BLACK);
-			  if(current_time.second == 0 && current_time.minute == 0 && current_time.hour == 0)
-			  {
-				  displayDate(LCD_WIDTH / 2, 240 + 32, &current_time.date, &current_time.month, &current_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-				  displayDay(20, 320 - 34, &current_time.day, 24, RED);
-			  }
-
-			  displayTimeLed7Seg(&current_time.second, &current_time.minute, &current_time.hour);
-		  }
-
-		  if(button_count[12] == 1)
-		  {
-			  current_mode = Mode_config_time;
-			  button_count[12] += 1;
-		  }
-
-		  break;
-	  }
-	  case Mode_config_time:
-	  {
-		  if(previous_mode != current_mode)
-		  {
-			  ds3231ReadTime();
-			  set_time.second = current_time.second;
-			  set_time.minute = current_time.minute;
-			  set_time.hour = current_time.hour;
-			  set_time.day = current_time.day;
-			  set_time.date = current_time.date;
-			  set_time.month = current_time.month;
-			  set_time.year = current_time.year;
-
-			  lcdClear(WHITE);
-			  clock_radius = 100;
-			  displayClock(LCD_WIDTH / 2, 110, clock_radius);
-
-			  current_mode_config = Mode_config_second;
-			  previous_mode_config = Mode_config_minute;
-
-			  previous_mode = current_mode;
-		  }
-
-		  switch (current_mode_config)
-		  {
+	  schedulerRun();
+
+
+    /* USER CODE END WHILE */
+
+    /* USER CODE BEGIN 3 */
+  }
+  /* USER CODE END 3 */
+}
+
+/**
+  * @brief System Clock Configuration
+  * @retval None
+  */
+void SystemClock_Config(void)
+{
+  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
+  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+
+  /** Configure the main internal regulator output voltage
+  */
+  __HAL_RCC_PWR_CLK_ENABLE();
+  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+
+  /** Initializes the RCC Oscillators according to the specified parameters
+  * in the RCC_OscInitTypeDef structure.
+  */
+  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
+  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
+  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
+  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
+  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
+  RCC_OscInitStruct.PLL.PLLM = 8;
+  RCC_OscInitStruct.PLL.PLLN = 168;
+  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
+  RCC_OscInitStruct.PLL.PLLQ = 4;
+  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
+  {
+    Error_Handler();
+  }
+
+  /** Initializes the CPU, AHB and APB buses clocks
+  */
+  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
+                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
+  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
+  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
+  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV4;
+  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV4;
+
+  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_5) != HAL_OK)
+  {
+    Error_Handler();
+  }
+}
+
+/* USER CODE BEGIN 4 */
+/**
+ * @brief	user interface task, runs after every key event, ui tick and clock tick.
+ * 			a mode change clears the screen in bands and yields between them so input and events are not held up.
+ */
+Task_Result taskUi()
+{
+	bool tick_50ms = ui_tick_50ms;
+	bool tick_500ms = ui_tick_500ms;
+	bool temp_updated = ui_temp_updated;
+
+	PROFILER_BEGIN(PROF_TASK_UI);
+	if(current_mode != previous_mode && current_mode != Mode_init)
+	{
+		PROFILER_BEGIN(PROF_LCD_CLEAR);
+		bool cleared = lcdClearStep(WHITE, UI_CLEAR_ROWS);
+		PROFILER_END(PROF_LCD_CLEAR);
+
+		if(!cleared)
+		{
+			PROFILER_END(PROF_TASK_UI);
+			return TASK_YIELD;
+		}
+	}
+
+	ui_tick_50ms = false;
+	ui_tick_500ms = false;
+	ui_temp_updated = false;
+
+	// one key per run, a key may change the mode and the next one belongs to the new screen
+	Button_Event key = {0};
+	(void)buttonGetEvent(&key);
+	enum Action action = keymapLookup(current_mode, &key);
+	if(action != Action_none)
+	{
+		latencyDispatch(current_mode, &key);
+	}
+
+	if(tick_500ms)
+	{
+		deadlineMark(DEADLINE_CLOCK);
+	}
+
+	switch (current_mode)
+	{
+	case Mode_init:
+	{
+		led7SegSetColon(1);
+		setTime(&set_time.second, &set_time.minute, &set_time.hour, &set_time.day, &set_time.date, &set_time.month, &set_time.year);
+
+		current_time.alarm_on = false;
+
+		current_mode = Mode_config_time;
+
+		break;
+	}
+	case Mode_word_clock:
+	{
+		if(previous_mode != current_mode)
+		{
+			clock_radius = 100;
+			displayClock(LCD_WIDTH / 2, 110, clock_radius);
+
+			(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &current_time.second, BLUE);
+			(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &current_time.second, &current_time.minute, BLACK);
+			(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &current_time.minute, &current_time.hour, RED);
+
+			displayTime(LCD_WIDTH / 2, 240, &current_time.second, &current_time.minute, &current_time.hour, 32, BLACK, BLACK, BLACK);
+			displayDate(LCD_WIDTH / 2, 240 + 32, &current_time.date, &current_time.month, &current_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
+			displayDay(20, 320 - 10 - 24, &current_time.day, 24, RED);
+			if(temperatureIsValid())
+			{
+				displayTemp(140, 320 - 10 - 24, temperatureGetLatest(), 24, DARKBLUE);
+			}
+
+			if(current_time.alarm_on)
+			{
+				lcdShowString(20, 10, "ALARM", RED, WHITE, 24, 0);
+			}
+
+			temperatureRequest();
+			temp_ticks = 0;
+
+			previous_mode = current_mode;
+		}
+
+		if(temp_updated)
+		{
+			displayTemp(140, 320 - 10 - 24, temperatureGetLatest(), 24, DARKBLUE);
+		}
+
+		if(tick_500ms)
+		{
+			debugSystem();
+
+			(void)ds3231Poll(); // alarm flags are latched for ds3231GetFlagA1/A2
+
+			// alarm 1 always holds the earliest scheduled alarm
+			if(ds3231GetFlagA1() && alarmProcess(epochFromTime(&current_time)) != 0)
+			{
+				current_time.alarm_on = true;
+				lcdShowString(20, 10, "ALARM", RED, WHITE, 24, 0);
+				led7SegScroll("ALArM", 300);
+				rs232SendString((void*)"ALARM\r\n");
+			}
+
+			if(++temp_ticks >= TEMP_REQUEST_TICKS)
+			{
+				temperatureRequest();
+				temp_ticks = 0;
+			}
+
+			(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &current_time.second, BLUE);
+			(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &current_time.second, &current_time.minute, BLACK);
+			(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &current_time.minute, &current_time.hour, RED);
+
+			displayTime(LCD_WIDTH / 2, 240, &current_time.second, &current_time.minute, &current_time.hour, 32, BLACK, BLACK, BLACK);
+			if(current_time.second == 0 && current_time.minute == 0 && current_time.hour == 0)
+			{
+				displayDate(LCD_WIDTH / 2, 240 + 32, &current_time.date, &current_time.month, &current_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
+				displayDay(20, 320 - 34, &current_time.day, 24, RED);
+			}
+
+			if(!led7SegIsScrolling())
+			{
+				displayTimeLed7Seg(&current_time.second, &current_time.minute, &current_time.hour);
+			}
+		}
+
+		if(action == Action_config_time)
+		{
+			current_mode = Mode_config_time;
+		}
+		else if(action == Action_monitor)
+		{
+			current_mode = Mode_monitor_register;
+		}
+		else if(action == Action_config_alarm)
+		{
+			current_mode = Mode_config_alarm;
+		}
+		else if(action == Action_dismiss_alarm && current_time.alarm_on)
+		{
+			current_time.alarm_on = false;
+			lcdShowString(20, 10, "     ", RED, WHITE, 24, 0);
+			displayTimeLed7Seg(&current_time.second, &current_time.minute, &current_time.hour);
+		}
+
+		break;
+	}
+	case Mode_config_time:
+	{
+		if(previous_mode != current_mode)
+		{
+			(void)ds3231Poll();
+			set_time.second = current_time.second;
+			set_time.minute = current_time.minute;
+			set_time.hour = current_time.hour;
+			set_time.day = current_time.day;
+			set_time.date = current_time.date;
+			set_time.month = current_time.month;
+			set_time.year = current_time.year;
+
+			clock_radius = 100;
+			displayClock(LCD_WIDTH / 2, 110, clock_radius);
+
+			current_mode_config = Mode_config_second;
+			previous_mode_config = Mode_config_minute;
+
+			previous_mode = current_mode;
+		}
+
+		switch (current_mode_config)
+		{
 			case Mode_config_second:
 			{
 				if(previous_mode_config != current_mode_config)
@@ -283,59 +543,47 @@ int main(void)
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, RED, BLACK, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_second);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, LED7SEG_BLINK_DEBUG);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(sTimer2GetFlag())
-				{
-					static int counter = 0;
-					counter += 1;
-
-					if(counter % 4 == 0)
-					{
-						led7SegDebugTurnOff(6);
-						led7SegDebugTurnOff(7);
-						led7SegDebugTurnOff(8);
-					}
-					else if(counter % 2 == 0)
-					{
-						displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
-					}
-				}
-
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_minute;
-					button_count[11] += 1;
 				}
-				else if(button_count[3] % 20 == 1)
+				else if(action == Action_increase)
 				{
-					increaseSec();
+					if(increaseSec())
+					{
+						displaySetDate(Mode_config_second);
+					}
 
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, BLACK);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, BLUE);
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, RED);
 
 				    displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, RED, BLACK, BLACK);
-
-					button_count[3] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, LED7SEG_BLINK_DEBUG);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
-					decreaseSec();
+					if(decreaseSec())
+					{
+						displaySetDate(Mode_config_second);
+					}
 
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, BLACK);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, BLUE);
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, RED);
 
 				    displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, RED, BLACK, BLACK);
-
-					button_count[7] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, LED7SEG_BLINK_DEBUG);
 				}
 
 				break;
@@ -349,63 +597,51 @@ int main(void)
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, RED, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_minute);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x0c, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(sTimer2GetFlag())
-				{
-					static int counter = 0;
-					counter += 1;
-
-					if(counter % 4 == 0)
-					{
-						led7SegTurnOff(2);
-						led7SegTurnOff(3);
-					}
-					else if(counter % 2 == 0)
-					{
-						displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
-					}
-				}
-
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_hour;
-					button_count[11] += 1;
 				}
-				else if(button_count[15] % 30 == 1)
+				else if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_second;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1)
+				else if(action == Action_increase)
 				{
-					increaseMin();
+					if(increaseMin())
+					{
+						displaySetDate(Mode_config_minute);
+					}
 
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, BLACK);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, BLUE);
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, RED, BLACK);
-
-					button_count[3] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x0c, 0);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
-					decreaseMin();
+					if(decreaseMin())
+					{
+						displaySetDate(Mode_config_minute);
+					}
 
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, BLACK);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, BLUE);
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, RED, BLACK);
-
-					button_count[7] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x0c, 0);
 				}
 
 				break;
@@ -419,63 +655,51 @@ int main(void)
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, RED);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_hour);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x03, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(sTimer2GetFlag())
-				{
-					static int counter = 0;
-					counter += 1;
-
-					if(counter % 4 == 0)
-					{
-						led7SegTurnOff(0);
-						led7SegTurnOff(1);
-					}
-					else if(counter % 2 == 0)
-					{
-						displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
-					}
-				}
-
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_day;
-					button_count[11] += 1;
 				}
-				else if(button_count[15] % 30 == 1)
+				else if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_minute;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1) // check button is held 1 second
+				else if(action == Action_increase)
 				{
-					increaseHour();
+					if(increaseHour())
+					{
+						displaySetDate(Mode_config_hour);
+					}
 
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, BLACK);
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, BLUE);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, RED);
-
-					button_count[3] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x03, 0);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
-					decreaseHour();
+					if(decreaseHour())
+					{
+						displaySetDate(Mode_config_hour);
+					}
 
 					(void)displaySecClockwise(LCD_WIDTH / 2, 110, clock_radius - 30, &set_time.second, BLACK);
 					(void)displayMinClockwise(LCD_WIDTH / 2, 110, clock_radius - 40, &set_time.second, &set_time.minute, BLUE);
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, RED);
-
-					button_count[7] += 1;
+					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0x03, 0);
 				}
 
 				break;
@@ -489,39 +713,33 @@ int main(void)
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, RED);
+					displaySetDate(Mode_config_day);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_date;
-					button_count[11] += 1;
 				}
-				else if(button_count[15] % 30 == 1)
+				else if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_hour;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1) // check button is held 1 second
+				else if(action == Action_increase)
 				{
 					increaseDay();
 
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, RED);
-
-					button_count[3] += 1;
+					displaySetDate(Mode_config_day);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
 					decreaseDay();
 
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, RED);
-
-					button_count[7] += 1;
+					displaySetDate(Mode_config_day);
 				}
 
 
@@ -536,39 +754,33 @@ int main(void)
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, RED, DARKBLUE, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_date);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_month;
-					button_count[11] += 1;
 				}
-				else if(button_count[15] % 30 == 1)
+				else if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_day;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1) // check button is held 1 second
+				else if(action == Action_increase)
 				{
 					increaseDate();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, RED, DARKBLUE, DARKBLUE);
-
-					button_count[3] += 1;
+					displaySetDate(Mode_config_date);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
 					decreaseDate();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, RED, DARKBLUE, DARKBLUE);
-
-					button_count[7] += 1;
+					displaySetDate(Mode_config_date);
 				}
 
 				break;
@@ -582,39 +794,33 @@ int main(void)
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, RED, DARKBLUE);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_month);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(button_count[11] % 30 == 1) // check button is held 1.5 second
+				if(action == Action_next_field)
 				{
 					current_mode_config = Mode_config_year;
-					button_count[11] += 1;
 				}
-				else if(button_count[15] % 30 == 1)
+				else if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_date;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1) // check button is held 1 second
+				else if(action == Action_increase)
 				{
 					increaseMonth();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, RED, DARKBLUE);
-
-					button_count[3] += 1;
+					displaySetDate(Mode_config_month);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
 					decreaseMonth();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, RED, DARKBLUE);
-
-					button_count[7] += 1;
+					displaySetDate(Mode_config_month);
 				}
 
 				break;
@@ -628,143 +834,382 @@ int main(void)
 					(void)displayHourClockwise(LCD_WIDTH / 2, 110, clock_radius - 50, &set_time.minute, &set_time.hour, RED);
 
 					displayTime(LCD_WIDTH / 2, 240, &set_time.second, &set_time.minute, &set_time.hour, 32, BLACK, BLACK, BLACK);
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, RED);
-					displayDay(20, 320 - 10 - 24, &set_time.day, 24, DARKBLUE);
+					displaySetDate(Mode_config_year);
 
 					displayTimeLed7Seg(&set_time.second, &set_time.minute, &set_time.hour);
+					led7SegBlink(0, 0);
 
 					previous_mode_config = current_mode_config;
 				}
 
-				if(button_count[15] % 30 == 1)
+				if(action == Action_previous_field)
 				{
 					current_mode_config = Mode_config_month;
-					button_count[15] += 1;
 				}
-				else if(button_count[3] % 20 == 1) // check button is held 1 second
+				else if(action == Action_increase)
 				{
 					increaseYear();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, RED);
-
-					button_count[3] += 1;
+					displaySetDate(Mode_config_year);
 				}
-				else if(button_count[7] % 20 == 1)
+				else if(action == Action_decrease)
 				{
 					decreaseYear();
 
-					displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24, DARKBLUE, DARKBLUE, RED);
-
-					button_count[7] += 1;
+					displaySetDate(Mode_config_year);
 				}
 
 				break;
 			}
 		}
 
-		if(button_count[12] == 1)
+		if(action == Action_save)
 		{
-		  setTime(&set_time.second, &set_time.minute, &set_time.hour, &set_time.day, &set_time.date, &set_time.month, &set_time.year);
-		  current_mode = Mode_word_clock;
-		  button_count[12] += 1;
+			setTime(&set_time.second, &set_time.minute, &set_time.hour, &set_time.day, &set_time.date, &set_time.month, &set_time.year);
+			alarmReschedule(epochFromTime(&set_time));
+			led7SegBlink(0, 0);
+			current_mode = Mode_word_clock;
 		}
-		else if(button_count[14] == 1)
+		else if(action == Action_back)
 		{
-		  current_mode = Mode_word_clock;
-		  button_count[14] += 1;
+			led7SegBlink(0, 0);
+			current_mode = Mode_word_clock;
 		}
 
 		break;
-	  }
-	  case Mode_config_alarm:
-	  {
-		  break;
-	  }
-	  case Mode_stopwatch:
-	  {
-		  break;
-	  }
-	  case Mode_timers:
-	  {
-		  break;
-	  }
-	  case Mode_monitor_register:
-	  {
-		  break;
-	  }
-	  default:
-	  {
-		  current_mode = Mode_init;
-	  }
-	  }
+	}
+	case Mode_config_alarm:
+	{
+		if(previous_mode != current_mode)
+		{
+			(void)ds3231Poll();
+			set_alarm_1.second = 0;
+			set_alarm_1.minute = current_time.minute;
+			set_alarm_1.hour = current_time.hour;
+			set_alarm_1.date = current_time.date;
+			alarm_field = 0;
+			alarm_repeat = ALARM_DAILY;
 
+			lcdShowString(20, 10, "ALARM", BLACK, WHITE, 24, 0);
 
-    /* USER CODE END WHILE */
+			displayTime(LCD_WIDTH / 2, 120, &set_alarm_1.second, &set_alarm_1.minute, &set_alarm_1.hour, 32, BLACK, BLACK, RED);
+			displayAlarmRepeat(20, 200, alarm_repeat, 24, DARKBLUE);
+			displayAlarmCount(20, 240, 24);
 
-    /* USER CODE BEGIN 3 */
-  }
-  /* USER CODE END 3 */
-}
+			previous_mode = current_mode;
+		}
 
-/**
-  * @brief System Clock Configuration
-  * @retval None
-  */
-void SystemClock_Config(void)
-{
-  RCC_OscInitTypeDef RCC_OscInitStruct = {0};
-  RCC_ClkInitTypeDef RCC_ClkInitStruct = {0};
+		if(action == Action_next_field)
+		{
+			alarm_field ^= 1;
+			displayTime(LCD_WIDTH / 2, 120, &set_alarm_1.second, &set_alarm_1.minute, &set_alarm_1.hour, 32,
+					BLACK, alarm_field ? RED : BLACK, alarm_field ? BLACK : RED);
+		}
+		else if(action == Action_increase || action == Action_decrease)
+		{
+			int8_t step = (action == Action_increase) ? 1 : -1;
+			if(alarm_field)
+			{
+				set_alarm_1.minute = (set_alarm_1.minute + 60 + step) % 60;
+			}
+			else
+			{
+				set_alarm_1.hour = (set_alarm_1.hour + 24 + step) % 24;
+			}
+			displayTime(LCD_WIDTH / 2, 120, &set_alarm_1.second, &set_alarm_1.minute, &set_alarm_1.hour, 32,
+					BLACK, alarm_field ? RED : BLACK, alarm_field ? BLACK : RED);
+		}
+		else if(action == Action_next_repeat)
+		{
+			alarm_repeat = (alarm_repeat + 1) % (ALARM_MONTHLY + 1);
+			displayAlarmRepeat(20, 200, alarm_repeat, 24, DARKBLUE);
+		}
+		else if(action == Action_save)
+		{
+			Alarm alarm = {0};
+			alarm.repeat = alarm_repeat;
+			alarm.hour = set_alarm_1.hour;
+			alarm.minute = set_alarm_1.minute;
+			alarm.second = set_alarm_1.second;
+			alarm.weekdays = ALARM_WEEKDAYS;
+			alarm.date = set_alarm_1.date;
+
+			(void)alarmAdd(&alarm, epochFromTime(&current_time));
+			displayAlarmCount(20, 240, 24);
+		}
+		else if(action == Action_clear_alarms)
+		{
+			alarmClear();
+			displayAlarmCount(20, 240, 24);
+		}
+		else if(action == Action_back)
+		{
+			current_mode = Mode_word_clock;
+		}
 
-  /** Configure the main internal regulator output voltage
-  */
-  __HAL_RCC_PWR_CLK_ENABLE();
-  __HAL_PWR_VOLTAGESCALING_CONFIG(PWR_REGULATOR_VOLTAGE_SCALE1);
+		break;
+	}
+	case Mode_stopwatch:
+	{
+		break;
+	}
+	case Mode_timers:
+	{
+		break;
+	}
+	case Mode_monitor_register:
+	{
+		if(previous_mode != current_mode)
+		{
+			displayRegisterLayout();
 
-  /** Initializes the RCC Oscillators according to the specified parameters
-  * in the RCC_OscInitTypeDef structure.
-  */
-  RCC_OscInitStruct.OscillatorType = RCC_OSCILLATORTYPE_HSI;
-  RCC_OscInitStruct.HSIState = RCC_HSI_ON;
-  RCC_OscInitStruct.HSICalibrationValue = RCC_HSICALIBRATION_DEFAULT;
-  RCC_OscInitStruct.PLL.PLLState = RCC_PLL_ON;
-  RCC_OscInitStruct.PLL.PLLSource = RCC_PLLSOURCE_HSI;
-  RCC_OscInitStruct.PLL.PLLM = 8;
-  RCC_OscInitStruct.PLL.PLLN = 168;
-  RCC_OscInitStruct.PLL.PLLP = RCC_PLLP_DIV2;
-  RCC_OscInitStruct.PLL.PLLQ = 4;
-  if (HAL_RCC_OscConfig(&RCC_OscInitStruct) != HAL_OK)
-  {
-    Error_Handler();
-  }
+			if(ds3231ReadAllRegisters())
+			{
+				displayRegisterMonitor(true);
+			}
+			monitor_ticks = 0;
 
-  /** Initializes the CPU, AHB and APB buses clocks
-  */
-  RCC_ClkInitStruct.ClockType = RCC_CLOCKTYPE_HCLK|RCC_CLOCKTYPE_SYSCLK
-                              |RCC_CLOCKTYPE_PCLK1|RCC_CLOCKTYPE_PCLK2;
-  RCC_ClkInitStruct.SYSCLKSource = RCC_SYSCLKSOURCE_PLLCLK;
-  RCC_ClkInitStruct.AHBCLKDivider = RCC_SYSCLK_DIV1;
-  RCC_ClkInitStruct.APB1CLKDivider = RCC_HCLK_DIV4;
-  RCC_ClkInitStruct.APB2CLKDivider = RCC_HCLK_DIV4;
+			previous_mode = current_mode;
+		}
 
-  if (HAL_RCC_ClockConfig(&RCC_ClkInitStruct, FLASH_LATENCY_5) != HAL_OK)
-  {
-    Error_Handler();
-  }
+		if(tick_50ms && ++monitor_ticks >= MONITOR_REFRESH_TICKS)
+		{
+			monitor_ticks = 0;
+
+			// one burst read per refresh, only repaint the cells that differ from the last snapshot
+			if(ds3231ReadAllRegisters())
+			{
+				displayRegisterMonitor(false);
+			}
+		}
+
+		if(action == Action_back)
+		{
+			current_mode = Mode_word_clock;
+		}
+
+		break;
+	}
+	default:
+	{
+		current_mode = Mode_init;
+	}
+	}
+
+	if(current_mode != traced_mode)
+	{
+		TRACE(TRACE_MODE, traced_mode, current_mode);
+		traced_mode = current_mode;
+	}
+	if(current_mode == previous_mode)
+	{
+		latencyComplete(); // not after a mode change, the new screen is drawn by the next runs
+	}
+	PROFILER_END(PROF_TASK_UI);
+	return buttonPending() ? TASK_YIELD : TASK_DONE;
+}
+
+/**
+ * @brief handle one character command received over rs232
+ * @param command 'i': i2c bus statistic, 'a': scheduled alarms, 'e': event and button queues, 's': scheduler tasks, 'u': cpu load, 'p': profiler zones, 'd': deadline and jitter, 't': trace dump, 'b': 7 segment brightness and cost,
+ * 			'c': temperature min/max/mean, 'l': key latency per mode, 'L': clear it, '0'-'9' 'A'-'F': press and release that key without touching it
+ */
+void uartCommand(uint8_t command)
+{
+	switch (command)
+	{
+		case 'i':
+		{
+			i2cBusReport();
+			break;
+		}
+		case 'a':
+		{
+			alarmReport();
+			break;
+		}
+		case 'e':
+		{
+			eventReport();
+			buttonReport();
+			break;
+		}
+		case 's':
+		{
+			schedulerReport();
+			break;
+		}
+		case 'u':
+		{
+			powerReport();
+			break;
+		}
+		case 'p':
+		{
+			profilerReport();
+			break;
+		}
+		case 'd':
+		{
+			deadlineReport();
+			break;
+		}
+		case 't':
+		{
+			traceDump();
+			break;
+		}
+		case 'c':
+		{
+			temperatureReport();
+			break;
+		}
+		case 'b':
+		{
+			led7SegReport();
+			break;
+		}
+		case 'l':
+		{
+			latencyReport();
+			break;
+		}
+		case 'L':
+		{
+			latencyReset();
+			break;
+		}
+		default:
+		{
+			uint8_t key = BUTTON_COUNT;
+			if(command >= '0' && command <= '9')
+			{
+				key = command - '0';
+			}
+			else if(command >= 'A' && command <= 'F')
+			{
+				key = command - 'A' + 10;
+			}
+
+			// the input task wakes the ui for them like for scanned events
+			if(key < BUTTON_COUNT && buttonInject(key, BUTTON_PRESS))
+			{
+				(void)buttonInject(key, BUTTON_RELEASE);
+			}
+			break;
+		}
+	}
+}
+
+/**
+ * @brief	dispatch everything the interrupts queued, oldest first
+ */
+Task_Result taskEvent()
+{
+	Event event;
+
+	deadlineMark(DEADLINE_EVENT);
+	PROFILER_BEGIN(PROF_TASK_EVENT);
+	while(eventGet(&event))
+	{
+		switch (event.type)
+		{
+			case EVENT_TICK_50MS:
+			{
+				ui_tick_50ms = true;
+				schedulerTrigger(task_ui);
+				break;
+			}
+			case EVENT_TICK_500MS:
+			{
+				ui_tick_500ms = true;
+				applyBrightnessSchedule();
+				schedulerTrigger(task_ui);
+				break;
+			}
+			case EVENT_UART_RX:
+			{
+				uartCommand(event.data);
+				break;
+			}
+			default:
+			{
+				break;
+			}
+		}
+	}
+	PROFILER_END(PROF_TASK_EVENT);
+	return TASK_DONE;
+}
+
+/**
+ * @brief	button scan, the ui task handles new button events right after
+ */
+Task_Result taskInput()
+{
+	deadlineMark(DEADLINE_INPUT);
+	PROFILER_BEGIN(PROF_TASK_INPUT);
+	buttonScan();
+	PROFILER_END(PROF_TASK_INPUT);
+
+	if(buttonPending())
+	{
+		schedulerTrigger(task_ui);
+	}
+	return TASK_DONE;
+}
+
+Task_Result taskTemperature()
+{
+	deadlineMark(DEADLINE_TEMP);
+	PROFILER_BEGIN(PROF_TASK_TEMP);
+	if(temperatureProcess())
+	{
+		ui_temp_updated = true;
+		schedulerTrigger(task_ui);
+	}
+	PROFILER_END(PROF_TASK_TEMP);
+	return TASK_DONE;
+}
+
+Task_Result taskPower()
+{
+	powerUpdateLoad();
+	return TASK_DONE;
 }
 
-/* USER CODE BEGIN 4 */
 void debugSystem()
 {
 	HAL_GPIO_TogglePin(GPIOE, LED_DEBUG_Pin);
 }
 void initSystem()
 {
-	initTimer2();
-	initTimer4();
+	initEvent();
+	initScheduler();
+	initProfiler();
+	initSTimer();
+	initTimebase();
+	initTrace();
+	initDeadline();
+	initLatency();
 	initLCD();
+	initSPIBus();
 	initLed7Seg();
+	initRS232();
+	initI2CBus();
 	initds3231();
+	initAlarm();
+	initTemperature();
 	initButton();
+	buttonConfigure(3, &key_adjust);
+	buttonConfigure(7, &key_adjust);
+	buttonConfigure(11, &key_field);
+	buttonConfigure(15, &key_field);
+	if(!keymapLoad(keymap_panel, sizeof(keymap_panel) / sizeof(keymap_panel[0])))
+	{
+		rs232SendString((void*)"Keymap has invalid or duplicate entries\r\n");
+	}
+	initPower(); // last, load window starts after the slow init
 }
 void setTime(uint8_t *second, uint8_t *minute, uint8_t *hour, uint8_t *day, uint8_t *date, uint8_t *month, uint16_t *year)
 {
@@ -781,6 +1226,7 @@ void displayClock(int x_coor, int y_coor, int radius)
 {
     const uint8_t char_size = 24;
 
+    PROFILER_BEGIN(PROF_DISPLAY_CLOCK);
     lcdDrawCircle(x_coor, y_coor, DARKBLUE, radius + 2, 1);
 	lcdDrawCircle(x_coor, y_coor, WHITE, radius, 1);
 
@@ -792,6 +1238,7 @@ void displayClock(int x_coor, int y_coor, int radius)
 
         lcdShowIntNumCenter(x, y, ((i == 0) ? 12 : i), 2, BLACK, WHITE, char_size, 1);
     }
+    PROFILER_END(PROF_DISPLAY_CLOCK);
 }
 
 /**
@@ -873,11 +1320,105 @@ void displayDate(int x_coor, int y_coor, const uint8_t *date, const uint8_t *mon
 	lcdShowStringCenter(x_coor - (char_size * 2) + char_size, y_coor, "/", color_month, WHITE, char_size, 1);
 }
 
-void displayTemp(int x_coor, int y_coor, float temperature, uint8_t char_size, uint16_t color_temp)
+/**
+ * @brief display temperature as [-]xx.xxC without float formatting
+ * @param temperature fixed point temperature in quarter degree Celsius
+ */
+void displayTemp(int x_coor, int y_coor, int16_t temperature, uint8_t char_size, uint16_t color_temp)
 {
-	lcdShowFloatNum(x_coor, y_coor, temperature, 4, color_temp, WHITE, char_size, 0);
+	char temp_str[8];
+	uint8_t index = 0;
+	uint16_t abs_temp = (temperature < 0) ? -temperature : temperature;
+	uint16_t integer = abs_temp / 4;
+	uint8_t hundredth = (abs_temp % 4) * 25;
+
+	temp_str[index++] = (temperature < 0) ? '-' : ' ';
+	temp_str[index++] = (integer >= 10) ? '0' + integer / 10 % 10 : ' ';
+	temp_str[index++] = '0' + integer % 10;
+	temp_str[index++] = '.';
+	temp_str[index++] = '0' + hundredth / 10;
+	temp_str[index++] = '0' + hundredth % 10;
+	temp_str[index++] = 'C';
+	temp_str[index] = '\0';
+
+	lcdShowString(x_coor, y_coor, temp_str, color_temp, WHITE, char_size, 0);
 	return;
 }
+/**
+ * @brief display repeat kind of the alarm being configured
+ */
+void displayAlarmRepeat(int x_coor, int y_coor, Alarm_Repeat repeat, uint8_t char_size, uint16_t color_repeat)
+{
+	switch (repeat)
+	{
+		case ALARM_ONCE:
+		{
+			lcdShowString(x_coor, y_coor, "Once    ", color_repeat, WHITE, char_size, 0);
+			break;
+		}
+		case ALARM_DAILY:
+		{
+			lcdShowString(x_coor, y_coor, "Daily   ", color_repeat, WHITE, char_size, 0);
+			break;
+		}
+		case ALARM_WEEKLY:
+		{
+			lcdShowString(x_coor, y_coor, "Weekdays", color_repeat, WHITE, char_size, 0);
+			break;
+		}
+		case ALARM_MONTHLY:
+		{
+			lcdShowString(x_coor, y_coor, "Monthly ", color_repeat, WHITE, char_size, 0);
+			break;
+		}
+		default:
+		{
+			break;
+		}
+	}
+}
+
+void displayAlarmCount(int x_coor, int y_coor, uint8_t char_size)
+{
+	lcdShowString(x_coor, y_coor, "Alarms:", BLACK, WHITE, char_size, 0);
+	lcdShowIntNum(x_coor + 7 * (char_size / 2), y_coor, alarmCount(), 1, BLACK, WHITE, char_size, 0);
+}
+
+/**
+ * @brief	set the 7 segment brightness of the current time of day from brightness_schedule
+ * @note	uses the time of the last ds3231 read, led7SegSetBrightness does nothing if the level is the same
+ */
+void applyBrightnessSchedule()
+{
+	uint16_t now = current_time.hour * 60 + current_time.minute;
+	uint8_t count = sizeof(brightness_schedule) / sizeof(brightness_schedule[0]);
+	uint8_t level = brightness_schedule[count - 1].level;
+
+	for (uint8_t i = 0; i < count; i++)
+	{
+		if (brightness_schedule[i].hour * 60 + brightness_schedule[i].minute > now)
+		{
+			break;
+		}
+		level = brightness_schedule[i].level;
+	}
+
+	led7SegSetBrightness(LED7SEG_ALL, level);
+}
+
+/**
+ * @brief	redraw date and day of set_time, the field being set in red
+ * @param	field Mode_config_day to Mode_config_year, any other field draws all of them in blue
+ */
+void displaySetDate(enum State_config field)
+{
+	displayDate(LCD_WIDTH / 2, 240 + 32, &set_time.date, &set_time.month, &set_time.year, 24,
+			(field == Mode_config_date) ? RED : DARKBLUE,
+			(field == Mode_config_month) ? RED : DARKBLUE,
+			(field == Mode_config_year) ? RED : DARKBLUE);
+	displayDay(20, 320 - 10 - 24, &set_time.day, 24, (field == Mode_config_day) ? RED : DARKBLUE);
+}
+
 void displayDay(int x_coor, int y_coor, const uint8_t *day, uint8_t char_size, uint16_t color_day)
 {
 	switch (*day)
@@ -948,281 +1489,160 @@ void displayTimeLed7Seg(const uint8_t *second, const uint8_t *minute, const uint
 		led7SegDebugTurnOff(8);
 	}
 
-	led7SegSetDigit(*hour / 10, 0, 0);
-	led7SegSetDigit(*hour % 10, 1, 0);
-
-	led7SegSetDigit(*minute / 10, 2, 0);
-	led7SegSetDigit(*minute % 10, 3, 0);
+	led7SegShowTime(*hour, *minute);
 
 	return;
 }
 
-void increaseSec()
+/**
+ * @brief draw the static part of the register monitor: header and register address column
+ */
+void displayRegisterLayout()
 {
-    if (set_time.second < 59)
-    {
-        set_time.second += 1;
-    }
-    else
-    {
-        set_time.second = 0;
-        if (set_time.minute < 59)
-        {
-            set_time.minute += 1;
-        }
-        else
-        {
-            set_time.minute = 0;
-            if (set_time.hour < 23)
-            {
-                set_time.hour += 1;
-            }
-            else
-            {
-                set_time.hour = 0;
-            }
-        }
-    }
+	char address_str[5] = "0x00";
+	const char hex_digit[] = "0123456789ABCDEF";
+
+	lcdShowString(0, 0, "REG    HEX  7 6 5 4 3 2 1 0", WHITE, DARKBLUE, MONITOR_CHAR_SIZE, 0);
+	for(uint8_t reg = 0; reg < DS3231_REG_COUNT; reg++)
+	{
+		address_str[2] = hex_digit[reg >> 4];
+		address_str[3] = hex_digit[reg & 0x0f];
+		lcdShowString(0, MONITOR_CHAR_SIZE * (reg + 1), address_str, DARKBLUE, WHITE, MONITOR_CHAR_SIZE, 0);
+	}
 }
-void decreaseSec()
+
+/**
+ * @brief display ds3231_registers[] as hex and bit field, bits changed since the last snapshot are drawn in red
+ * @param full_redraw redraw every cell instead of only the cells that differ from the last snapshot
+ */
+void displayRegisterMonitor(bool full_redraw)
 {
-    if (set_time.second > 0)
-    {
-        set_time.second -= 1;
-    }
-    else
-    {
-        set_time.second = 59;
-        if (set_time.minute > 0)
-        {
-            set_time.minute -= 1;
-        }
-        else
-        {
-            set_time.minute = 59;
-            if (set_time.hour > 0)
-            {
-                set_time.hour -= 1;
-            }
-            else
-            {
-                set_time.hour = 23;
-            }
-        }
-    }
+	static uint8_t snapshot[DS3231_REG_COUNT];
+	static uint8_t highlight[DS3231_REG_COUNT]; // bits currently drawn in red
+
+	const char hex_digit[] = "0123456789ABCDEF";
+
+	for(uint8_t reg = 0; reg < DS3231_REG_COUNT; reg++)
+	{
+		uint8_t value = ds3231_registers[reg];
+		uint8_t changed = full_redraw ? 0x00 : (value ^ snapshot[reg]);
+		uint8_t repaint = full_redraw ? 0xff : (changed | highlight[reg]);
+		uint16_t y = MONITOR_CHAR_SIZE * (reg + 1);
+
+		if(full_redraw || changed || highlight[reg])
+		{
+			char hex_str[3] = {hex_digit[value >> 4], hex_digit[value & 0x0f], '\0'};
+			lcdShowString(MONITOR_HEX_X, y, hex_str, changed ? RED : BLACK, WHITE, MONITOR_CHAR_SIZE, 0);
+		}
+
+		for(uint8_t bit = 0; repaint != 0 && bit < 8; bit++)
+		{
+			uint8_t mask = 0x80 >> bit;
+			if(repaint & mask)
+			{
+				lcdShowChar(MONITOR_BIT_X + bit * MONITOR_BIT_SPACING, y, (value & mask) ? '1' : '0',
+						(changed & mask) ? RED : BLACK, WHITE, MONITOR_CHAR_SIZE, 0);
+			}
+		}
+
+		snapshot[reg] = value;
+		highlight[reg] = changed;
+	}
 }
-void increaseMin()
+
+/**
+ * @brief	move set_time by a number of seconds, carries into minute, hour, date, month and year
+ * @note	day of week is derived from the new date, result is kept inside the ds3231 range
+ * @retval	true if the date changed so date and day need to be redrawn
+ */
+bool adjustSetTime(int32_t seconds)
 {
-    if (set_time.minute < 59)
-    {
-        set_time.minute += 1;
-    }
-    else
-    {
-        set_time.minute = 0;
-        if (set_time.hour < 23)
-        {
-            set_time.hour += 1;
-        }
-        else
-        {
-            set_time.hour = 0;
-        }
-    }
+	Epoch previous = epochFromTime(&set_time);
+	Epoch next = epochClamp(previous + seconds);
+
+	epochToTime(next, &set_time);
+	return (next / EPOCH_SECONDS_PER_DAY) != (previous / EPOCH_SECONDS_PER_DAY);
+}
+
+/**
+ * @brief	move set_time by a number of months, date is clamped to the end of the new month
+ */
+void adjustSetMonth(int32_t months)
+{
+	epochToTime(epochClamp(epochAddMonths(epochFromTime(&set_time), months)), &set_time);
 }
 
-void decreaseMin()
+bool increaseSec()
 {
-    if (set_time.minute > 0)
-    {
-        set_time.minute -= 1;
-    }
-    else
-    {
-        set_time.minute = 59;
-        if (set_time.hour > 0)
-        {
-            set_time.hour -= 1;
-        }
-        else
-        {
-            set_time.hour = 23;
-        }
-    }
+	return adjustSetTime(1);
 }
 
-void increaseHour()
+bool decreaseSec()
 {
-    if (set_time.hour < 23)
-    {
-        set_time.hour += 1;
-    }
-    else
-    {
-        set_time.hour = 0;
-    }
+	return adjustSetTime(-1);
 }
 
-void decreaseHour()
+bool increaseMin()
 {
-    if (set_time.hour > 0)
-    {
-        set_time.hour -= 1;
-    }
-    else
-    {
-        set_time.hour = 23;
-    }
+	return adjustSetTime(EPOCH_SECONDS_PER_MINUTE);
+}
+
+bool decreaseMin()
+{
+	return adjustSetTime(-EPOCH_SECONDS_PER_MINUTE);
 }
 
+bool increaseHour()
+{
+	return adjustSetTime(EPOCH_SECONDS_PER_HOUR);
+}
+
+bool decreaseHour()
+{
+	return adjustSetTime(-EPOCH_SECONDS_PER_HOUR);
+}
+
+/**
+ * @brief	day of week follows the date, so stepping the day moves the date by one day
+ */
 void increaseDay()
 {
-    if (set_time.day < 7)
-    {
-        set_time.day += 1;
-    }
-    else
-    {
-        set_time.day = 1;
-    }
+	(void)adjustSetTime(EPOCH_SECONDS_PER_DAY);
 }
 
 void decreaseDay()
 {
-    if (set_time.day > 1)
-    {
-        set_time.day -= 1;
-    }
-    else
-    {
-        set_time.day = 7;
-    }
+	(void)adjustSetTime(-EPOCH_SECONDS_PER_DAY);
 }
+
 void increaseDate()
 {
-    int daysInMonth = getDaysInMonth(set_time.month, set_time.year);
-    if (set_time.date < daysInMonth)
-    {
-        set_time.date += 1;
-    }
-    else
-    {
-        set_time.date = 1;
-        if (set_time.month < 12)
-        {
-            set_time.month += 1;
-        }
-        else
-        {
-            set_time.month = 1;
-            set_time.year += 1;
-        }
-    }
+	(void)adjustSetTime(EPOCH_SECONDS_PER_DAY);
 }
 
 void decreaseDate()
 {
-    if (set_time.date > 1)
-    {
-        set_time.date -= 1;
-    }
-    else
-    {
-        if (set_time.month > 1)
-        {
-            set_time.month -= 1;
-        }
-        else
-        {
-            set_time.month = 12;
-            set_time.year -= 1;
-        }
-        set_time.date = getDaysInMonth(set_time.month, set_time.year);
-    }
+	(void)adjustSetTime(-EPOCH_SECONDS_PER_DAY);
 }
 
 void increaseMonth()
 {
-    if (set_time.month < 12)
-    {
-        set_time.month += 1;
-    }
-    else
-    {
-        set_time.month = 1;
-        set_time.year += 1;
-    }
-
-    if(set_time.day > (uint8_t)(getDaysInMonth(set_time.month, set_time.year)))
-	{
-		set_time.day = (uint8_t)(getDaysInMonth(set_time.month, set_time.year));
-	}
+	adjustSetMonth(1);
 }
 
 void decreaseMonth()
 {
-    if (set_time.month > 1)
-    {
-        set_time.month -= 1;
-    }
-    else
-    {
-        set_time.month = 12;
-        set_time.year -= 1;
-    }
-
-    if(set_time.day > (uint8_t)(getDaysInMonth(set_time.month, set_time.year)))
-	{
-		set_time.day = (uint8_t)(getDaysInMonth(set_time.month, set_time.year));
-	}
+	adjustSetMonth(-1);
 }
 
 void increaseYear()
 {
-    set_time.year += 1;
-
-    if(set_time.day > (uint8_t)(getDaysInMonth(set_time.month, set_time.year)))
-	{
-		set_time.day = (uint8_t)(getDaysInMonth(set_time.month, set_time.year));
-	}
+	adjustSetMonth(12);
 }
 
 void decreaseYear()
 {
-    if (set_time.year > 0) // Assuming year 0 is a valid boundary
-    {
-        set_time.year -= 1;
-    }
-
-    if(set_time.day > (uint8_t)(getDaysInMonth(set_time.month, set_time.year)))
-    {
-        set_time.day = (uint8_t)(getDaysInMonth(set_time.month, set_time.year));
-    }
-}
-
-// Helper function to get the number of days in a month
-int getDaysInMonth(int month, int year)
-{
-    switch (month)
-    {
-        case 1: case 3: case 5: case 7: case 8: case 10: case 12:
-        {
-            return 31;
-        }
-        case 4: case 6: case 9: case 11:
-        {
-            return 30;
-        }
-        case 2:
-        {
-            if ((year % 4 == 0 && year % 100 != 0) || (year % 400 == 0))
-                return 29; // Leap year
-            else
-                return 28;
-        }
-        default:
-            return 30; // Default case, should not happen
-    }
+	adjustSetMonth(-12);
 }
 
 
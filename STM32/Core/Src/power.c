@@ -0,0 +1,109 @@
+/*
+ * power.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "power.h"
+#include "main.h"
+#include "utils.h"
+#include "sTimer.h"
+#include "event.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initPower(void);
+
+void powerIdle(void);
+void powerUpdateLoad(void);
+uint16_t powerGetLoad(void);
+
+void powerReport(void);
+
+/* Variables */
+static uint32_t power_window_tick = 0;
+static uint32_t power_window_cycles = 0;
+static uint32_t power_idle_cycles = 0;	// cycles the core counted while waiting in WFI
+static uint16_t power_load = 0;			// hundredths of percent, 10000 = 100%
+
+/* Functions */
+/**
+ * @brief	idle uses plain sleep mode: peripherals and their interrupts keep running, WFI wakes on any of them
+ */
+void initPower()
+{
+	initCycleCounter();
+	CLEAR_BIT(SCB->SCR, SCB_SCR_SLEEPDEEP_Msk);
+
+	power_window_tick = sTimerGetTick();
+	power_window_cycles = getCycleCounter();
+	power_idle_cycles = 0;
+}
+
+/**
+ * @brief	scheduler idle hook, sleep until the next interrupt.
+ * 			interrupts are masked around WFI so an event posted after the scheduler looked cannot be slept over:
+ * 			a pending interrupt still wakes the core and is served once they are unmasked.
+ */
+void powerIdle()
+{
+	__disable_irq();
+	if(!eventPending())
+	{
+		uint32_t start = getCycleCounter();
+		__DSB();
+		__WFI();
+		power_idle_cycles += getCycleCounter() - start;
+	}
+	__enable_irq();
+}
+
+/**
+ * @brief	close the load window once it is POWER_WINDOW_MS long.
+ * 			the core clock, and so CYCCNT, stops in sleep, so busy time is what CYCCNT counted outside WFI
+ * 			and the window length comes from the 1 ms tick. with a debugger holding the clock on in sleep
+ * 			the WFI time is counted by CYCCNT and removed as idle, so the result is the same.
+ */
+void powerUpdateLoad()
+{
+	uint32_t elapsed = sTimerGetTick() - power_window_tick;
+	if(elapsed < POWER_WINDOW_MS)
+	{
+		return;
+	}
+
+	uint32_t cycles = getCycleCounter();
+	uint32_t busy = (cycles - power_window_cycles) - power_idle_cycles;
+	uint64_t total = (uint64_t)elapsed * (SystemCoreClock / 1000);
+	uint64_t load = (uint64_t)busy * 10000 / total;
+
+	power_load = (load > 10000) ? 10000 : (uint16_t)load;
+
+	power_window_tick += elapsed;
+	power_window_cycles = cycles;
+	power_idle_cycles = 0;
+}
+
+/**
+ * @retval	cpu load of the last window in hundredths of percent
+ */
+uint16_t powerGetLoad()
+{
+	return power_load;
+}
+
+void powerReport()
+{
+	rs232SendString((void*)"CPU load:");
+	rs232SendNumPercent(power_load);
+	rs232SendString((void*)"%\r\n");
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,178 @@
+/*
+ * profiler.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "profiler.h"
+#include "main.h"
+#include "utils.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initProfiler(void);
+
+void profilerBegin(Profiler_Zone zone);
+void profilerEnd(Profiler_Zone zone);
+void profilerReset(void);
+
+void profilerReport(void);
+
+#ifdef PROFILER_ENABLE
+
+typedef struct
+{
+	Profiler_Zone zone;
+	uint32_t start;
+	uint32_t child;		// cycles of nested zones already closed
+}Profiler_Frame;
+
+/* Variables */
+static const char *const profiler_names[PROF_ZONE_COUNT] =
+{
+#define PROFILER_ZONE_NAME(id, name) name,
+	PROFILER_ZONES(PROFILER_ZONE_NAME)
+#undef PROFILER_ZONE_NAME
+};
+
+static Profiler_Stats profiler_stats[PROF_ZONE_COUNT];
+static Profiler_Frame profiler_stack[PROFILER_MAX_DEPTH];
+static uint8_t profiler_depth = 0;
+static uint32_t profiler_errors = 0;	// unbalanced begin/end or nesting too deep
+
+/* Functions */
+void initProfiler()
+{
+	initCycleCounter();
+	profilerReset();
+}
+
+void profilerBegin(Profiler_Zone zone)
+{
+	if(profiler_depth >= PROFILER_MAX_DEPTH)
+	{
+		profiler_errors++;
+		return;
+	}
+
+	Profiler_Frame *pFrame = &profiler_stack[profiler_depth++];
+	pFrame->zone = zone;
+	pFrame->child = 0;
+	pFrame->start = getCycleCounter(); // last, so the bookkeeping above is not measured
+}
+
+void profilerEnd(Profiler_Zone zone)
+{
+	uint32_t end = getCycleCounter();
+
+	if(profiler_depth == 0 || profiler_stack[profiler_depth - 1].zone != zone)
+	{
+		profiler_errors++;
+		return;
+	}
+
+	Profiler_Frame *pFrame = &profiler_stack[--profiler_depth];
+	uint32_t cycles = end - pFrame->start;
+	Profiler_Stats *pStats = &profiler_stats[zone];
+
+	pStats->count++;
+	pStats->total += cycles;
+	pStats->self += cycles - pFrame->child;
+	if(cycles < pStats->min)
+	{
+		pStats->min = cycles;
+	}
+	if(cycles > pStats->max)
+	{
+		pStats->max = cycles;
+	}
+
+	if(profiler_depth > 0)
+	{
+		profiler_stack[profiler_depth - 1].child += cycles;
+	}
+}
+
+void profilerReset()
+{
+	for(uint8_t zone = 0; zone < PROF_ZONE_COUNT; zone++)
+	{
+		profiler_stats[zone].count = 0;
+		profiler_stats[zone].min = UINT32_MAX;
+		profiler_stats[zone].max = 0;
+		profiler_stats[zone].total = 0;
+		profiler_stats[zone].self = 0;
+	}
+	profiler_depth = 0;
+	profiler_errors = 0;
+}
+
+/**
+ * @brief	print every zone that ran, times in microseconds, self is the mean per run without nested zones
+ */
+void profilerReport()
+{
+	uint32_t cycles_per_us = SystemCoreClock / 1000000;
+
+	for(uint8_t zone = 0; zone < PROF_ZONE_COUNT; zone++)
+	{
+		Profiler_Stats *pStats = &profiler_stats[zone];
+		if(pStats->count == 0)
+		{
+			continue;
+		}
+
+		rs232SendString((void*)profiler_names[zone]);
+		rs232SendString((void*)" n:");
+		rs232SendNum(pStats->count);
+		rs232SendString((void*)" min:");
+		rs232SendNum(pStats->min / cycles_per_us);
+		rs232SendString((void*)" mean:");
+		rs232SendNum((uint32_t)(pStats->total / pStats->count / cycles_per_us));
+		rs232SendString((void*)" max:");
+		rs232SendNum(pStats->max / cycles_per_us);
+		rs232SendString((void*)" self mean:");
+		rs232SendNum((uint32_t)(pStats->self / pStats->count / cycles_per_us));
+		rs232SendString((void*)"us\r\n");
+	}
+
+	rs232SendString((void*)"Profiler err:");
+	rs232SendNum(profiler_errors);
+	rs232SendString((void*)"\r\n");
+}
+
+#else
+
+void initProfiler()
+{
+}
+
+void profilerBegin(Profiler_Zone zone)
+{
+	(void)zone;
+}
+
+void profilerEnd(Profiler_Zone zone)
+{
+	(void)zone;
+}
+
+void profilerReset()
+{
+}
+
+void profilerReport()
+{
+	rs232SendString((void*)"Profiler disabled, build with PROFILER_ENABLE\r\n");
+}
+
+#endif /* PROFILER_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
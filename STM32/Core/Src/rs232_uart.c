@@ -6,6 +6,7 @@
  */
 
 #include "rs232_uart.h"
+#include "event.h"
 
 #ifdef __cplusplus
 extern "C"
@@ -16,9 +17,6 @@ extern "C"
 uint8_t receive_buffer1 = 0;
 uint8_t msg[100];
 
-Ring_Buffer rs232_rbuffer;
-bool rs232_flag = false;
-
 /* Functions */
 
 /**
@@ -28,7 +26,7 @@ bool rs232_flag = false;
  * @param exponent The exponent
  * @return uint32_t The result of base^exponent
  */
-uint32_t mypow(uint8_t base, uint8_t exponent)
+static uint32_t mypow(uint8_t base, uint8_t exponent)
 {
     uint32_t result = 1;
     while (exponent > 0)
@@ -117,7 +115,7 @@ void rs232SendNumPercent(uint32_t num)
 	sprintf((void*) msg, "%ld", num / 100);
 	rs232SendString(msg);
 	rs232SendString((void*)".");
-	sprintf((void*) msg, "%ld", num % 100);
+	sprintf((void*) msg, "%02ld", num % 100);
 	rs232SendString(msg);
 }
 
@@ -131,27 +129,14 @@ void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
 {
 	if (huart->Instance == USART1)
 	{
-		// rs232 isr
-		if(RBufferInsert(&rs232_rbuffer, receive_buffer1))
-		{
-			rs232_flag = true;
-		}
+		// rs232 isr, byte is handed to main loop through the uart event queue
+		(void)eventPost(EVENT_SOURCE_UART, EVENT_UART_RX, receive_buffer1);
 
 		// turn on the receice interrupt
 		HAL_UART_Receive_IT(&huart1, &receive_buffer1, 1);
 	}
 }
 
-bool rs232GetFlag()
-{
-	if (rs232_flag)
-	{
-		rs232_flag = false;
-		return true;
-	}
-	return false;
-}
-
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
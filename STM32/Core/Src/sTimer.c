@@ -8,112 +8,253 @@
 #include "sTimer.h"
 #include "tim.h"
 #include "led7Seg.h"
+#include "timebase.h"
+#include "deadline.h"
+#ifdef DS3231_SIM
+#include "ds3231Sim.h"
+#endif /* DS3231_SIM */
 
 #ifdef __cplusplus
 extern "C"
 {
 #endif /* __cplusplus */
 
-void initTimer2(void);
-void initTimer4(void);
+void initSTimer(void);
 
-void sTimer2Set(uint16_t delay, uint16_t period);
-void sTimer4Set(uint16_t delay, uint16_t period);
+void sTimerStart(STimer *pTimer, uint32_t delay, uint32_t period, STimer_Callback callback, void *context);
+void sTimerStop(STimer *pTimer);
+bool sTimerGetFlag(STimer *pTimer);
+bool sTimerIsActive(const STimer *pTimer);
 
-uint8_t sTimer2GetFlag(void);
-uint8_t sTimer4GetFlag(void);
+uint32_t sTimerGetTick(void);
+void sTimerTick(void);
 
-uint8_t timer_2_flag = 0;
-uint16_t timer_2_counter = 0;
-uint16_t timer_2_mul = 0;
+static void sTimerInsert(STimer *pTimer);
+static void sTimerUnlink(STimer *pTimer);
+static void sTimerExpire(STimer *pTimer);
 
-uint8_t timer_4_flag = 0;
-uint16_t timer_4_counter = 0;
-uint16_t timer_4_mul = 0;
+/* Variables */
+static STimer *stimer_wheel_0[STIMER_WHEEL0_SIZE];
+static STimer *stimer_wheel_1[STIMER_WHEEL1_SIZE];
+static volatile uint32_t stimer_tick = 0;
 
 /**
- * @brief	init timer function
+ * @brief	init timer service, TIM4 is the only hardware timer used
  */
-void initTimer2()
+void initSTimer()
 {
-	HAL_TIM_Base_Start_IT(&htim2);
+	for(uint16_t i = 0; i < STIMER_WHEEL0_SIZE; i++)
+	{
+		stimer_wheel_0[i] = NULL;
+	}
+	for(uint16_t i = 0; i < STIMER_WHEEL1_SIZE; i++)
+	{
+		stimer_wheel_1[i] = NULL;
+	}
+
+	HAL_TIM_Base_Start_IT(&htim4);
 }
 
-void initTimer4()
+/**
+ * @brief	start or restart a timer, O(1)
+ * @param	delay(ms) until first expiration, 0 is rounded up to the next tick
+ * @param	period(ms) between expirations, 0 for one shot
+ * @param	callback called in interrupt context on expiration, NULL to poll with sTimerGetFlag
+ */
+void sTimerStart(STimer *pTimer, uint32_t delay, uint32_t period, STimer_Callback callback, void *context)
 {
-	HAL_TIM_Base_Start_IT(&htim4);
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pTimer->active)
+	{
+		sTimerUnlink(pTimer);
+	}
+
+	pTimer->expire = stimer_tick + ((delay > 0) ? delay / STIMER_TICK_MS : 1);
+	pTimer->period = period / STIMER_TICK_MS;
+	pTimer->callback = callback;
+	pTimer->context = context;
+	pTimer->flag = false;
+	pTimer->overruns = 0;
+	pTimer->active = true;
+	sTimerInsert(pTimer);
+
+	__set_PRIMASK(primask);
 }
 
 /**
- * @brief	set timer duration(ms)
- * @param	delay(ms)
- * @param	period(ms)
+ * @brief	stop a timer, O(1), a pending flag is kept
  */
-void sTimer2Set(uint16_t delay, uint16_t period)
+void sTimerStop(STimer *pTimer)
 {
-	timer_2_mul = period / TIMER_2_CYCLES;
-	timer_2_counter = delay / TIMER_2_CYCLES;
-	timer_2_flag = 0;
+	uint32_t primask = __get_PRIMASK();
+	__disable_irq();
+
+	if(pTimer->active)
+	{
+		sTimerUnlink(pTimer);
+		pTimer->active = false;
+	}
+
+	__set_PRIMASK(primask);
+}
+
+/**
+ * @brief	get flag of a timer in flag mode and reset it
+ * @return	true if the timer expired since the last call
+ */
+bool sTimerGetFlag(STimer *pTimer)
+{
+	if(pTimer->flag)
+	{
+		pTimer->flag = false;
+		return true;
+	}
+	return false;
+}
+
+bool sTimerIsActive(const STimer *pTimer)
+{
+	return pTimer->active;
+}
+
+/**
+ * @brief	number of ticks since initSTimer
+ */
+uint32_t sTimerGetTick()
+{
+	return stimer_tick;
+}
+
+/**
+ * @brief	advance the wheel by one tick, call every STIMER_TICK_MS from interrupt
+ * 			level 1 slot is cascaded into level 0 once per level 0 turn, then only the current slot is expired.
+ * 			level 0 only holds timers less than one turn away so every timer in the current slot is due
+ */
+void sTimerTick()
+{
+	uint32_t tick = ++stimer_tick;
+
+	if((tick & STIMER_WHEEL0_MASK) == 0)
+	{
+		uint8_t slot = (tick >> STIMER_WHEEL0_BITS) & STIMER_WHEEL1_MASK;
+		STimer *pTimer = stimer_wheel_1[slot];
+		stimer_wheel_1[slot] = NULL;
+
+		while(pTimer != NULL)
+		{
+			STimer *pNext = pTimer->next;
+			sTimerInsert(pTimer);
+			pTimer = pNext;
+		}
+	}
+
+	STimer **pSlot = &stimer_wheel_0[tick & STIMER_WHEEL0_MASK];
+	while(*pSlot != NULL)
+	{
+		STimer *pTimer = *pSlot;
+		sTimerUnlink(pTimer);
+		sTimerExpire(pTimer);
+	}
 }
 
-void sTimer4Set(uint16_t delay, uint16_t period)
+/**
+ * @brief	put timer in the slot matching its remaining ticks
+ */
+static void sTimerInsert(STimer *pTimer)
 {
-	timer_4_mul = period / TIMER_4_CYCLES;
-	timer_4_counter = delay / TIMER_4_CYCLES;
-	timer_4_flag = 0;
+	uint32_t remaining = pTimer->expire - stimer_tick;
+	STimer **pHead;
+
+	if(remaining < STIMER_WHEEL0_SIZE)
+	{
+		pHead = &stimer_wheel_0[pTimer->expire & STIMER_WHEEL0_MASK];
+	}
+	else if(remaining < STIMER_WHEEL_SPAN)
+	{
+		pHead = &stimer_wheel_1[(pTimer->expire >> STIMER_WHEEL0_BITS) & STIMER_WHEEL1_MASK];
+	}
+	else
+	{
+		pHead = &stimer_wheel_1[((stimer_tick + STIMER_WHEEL_SPAN) >> STIMER_WHEEL0_BITS) & STIMER_WHEEL1_MASK];
+	}
+
+	pTimer->slot = pHead;
+	pTimer->prev = NULL;
+	pTimer->next = *pHead;
+	if(*pHead != NULL)
+	{
+		(*pHead)->prev = pTimer;
+	}
+	*pHead = pTimer;
 }
 
 /**
- * @brief	get flag timer fuction and auto reset flags and timer counter
- * @return	timer flag
+ * @brief	remove timer from its slot
  */
-uint8_t sTimer2GetFlag()
+static void sTimerUnlink(STimer *pTimer)
 {
-	if(timer_2_flag)
+	if(pTimer->prev != NULL)
 	{
-		timer_2_flag = 0;
-		timer_2_counter = timer_2_mul;
-		return 1;
+		pTimer->prev->next = pTimer->next;
 	}
-	return 0;
+	else
+	{
+		*pTimer->slot = pTimer->next;
+	}
+
+	if(pTimer->next != NULL)
+	{
+		pTimer->next->prev = pTimer->prev;
+	}
+	pTimer->next = NULL;
+	pTimer->prev = NULL;
+	pTimer->slot = NULL;
 }
 
-uint8_t sTimer4GetFlag()
+static void sTimerExpire(STimer *pTimer)
 {
-	if(timer_4_flag)
+	if(pTimer->period > 0)
+	{
+		pTimer->expire += pTimer->period;
+		sTimerInsert(pTimer);
+	}
+	else
+	{
+		pTimer->active = false;
+	}
+
+	if(pTimer->callback != NULL)
 	{
-		timer_4_flag = 0;
-		timer_4_counter = timer_4_mul;
-		return 1;
+		pTimer->callback(pTimer->context);
+	}
+	else
+	{
+		if(pTimer->flag && pTimer->overruns < UINT16_MAX)
+		{
+			pTimer->overruns++;
+		}
+		pTimer->flag = true;
 	}
-	return 0;
 }
+
 /**
- * @brief	callback function call every 1ms
+ * @brief	callback function, TIM4 every 1ms, TIM2 when the microsecond counter wraps
  */
 void HAL_TIM_PeriodElapsedCallback(TIM_HandleTypeDef *htim) {
 	if (htim->Instance == TIM2)
 	{
-		if (timer_2_counter > 0)
-		{
-			--timer_2_counter;
-		}
-		if (timer_2_counter <= 0)
-		{
-			timer_2_flag = 1;
-		}
+		timebaseOverflow();
 	}
 
 	if (htim->Instance == TIM4)
 	{
-		if (timer_4_counter > 0)
-		{
-			--timer_4_counter;
-		}
-		if (timer_4_counter <= 0)
-		{
-			timer_4_flag = 1;
-		}
+#ifdef DS3231_SIM
+		ds3231SimAdvance(STIMER_TICK_MS);
+#endif /* DS3231_SIM */
+		deadlineMark(DEADLINE_TICK);
+		sTimerTick();
 		led7SegDisplay();
 	}
 }
@@ -0,0 +1,196 @@
+/*
+ * scheduler.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "scheduler.h"
+#include "sTimer.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initScheduler(void);
+
+uint8_t schedulerAdd(const char *name, Task_Function function, Task_Priority priority, uint32_t period, uint32_t deadline);
+void schedulerTrigger(uint8_t id);
+void schedulerSetIdleHook(Idle_Hook hook);
+void schedulerRun(void);
+
+void schedulerReport(void);
+
+static void schedulerRelease(uint32_t now);
+static uint8_t schedulerPick(void);
+
+/* Variables */
+Task scheduler_tasks[SCHEDULER_MAX_TASKS];
+
+static uint8_t scheduler_count = 0;
+static Idle_Hook scheduler_idle_hook = NULL;
+
+/* Functions */
+void initScheduler()
+{
+	scheduler_count = 0;
+	scheduler_idle_hook = NULL;
+}
+
+/**
+ * @brief	register a task, tasks of the same priority run in registration order
+ * @param	period(ms) 0 for a task released only by schedulerTrigger
+ * @param	deadline(ms) after release, used to count misses
+ * @retval	task id, SCHEDULER_NO_TASK if the table is full
+ */
+uint8_t schedulerAdd(const char *name, Task_Function function, Task_Priority priority, uint32_t period, uint32_t deadline)
+{
+	if(scheduler_count >= SCHEDULER_MAX_TASKS)
+	{
+		return SCHEDULER_NO_TASK;
+	}
+
+	Task *pTask = &scheduler_tasks[scheduler_count];
+	pTask->name = name;
+	pTask->function = function;
+	pTask->priority = priority;
+	pTask->period = period;
+	pTask->deadline = deadline;
+	pTask->next_release = sTimerGetTick() + period;
+	pTask->release = 0;
+	pTask->ready = false;
+	pTask->runs = 0;
+	pTask->misses = 0;
+	pTask->max_lateness = 0;
+
+	return scheduler_count++;
+}
+
+/**
+ * @brief	release a task now, a task already waiting keeps its first release time
+ */
+void schedulerTrigger(uint8_t id)
+{
+	Task *pTask = &scheduler_tasks[id];
+	if(!pTask->ready)
+	{
+		pTask->release = sTimerGetTick();
+		pTask->ready = true;
+	}
+}
+
+/**
+ * @brief	hook called when no task is ready
+ */
+void schedulerSetIdleHook(Idle_Hook hook)
+{
+	scheduler_idle_hook = hook;
+}
+
+/**
+ * @brief	one dispatch: release due periodic tasks then run the highest priority ready task once.
+ * 			a yielding task stays ready, so higher priority work released meanwhile runs first.
+ */
+void schedulerRun()
+{
+	uint32_t now = sTimerGetTick();
+	schedulerRelease(now);
+
+	uint8_t id = schedulerPick();
+	if(id == SCHEDULER_NO_TASK)
+	{
+		if(scheduler_idle_hook != NULL)
+		{
+			scheduler_idle_hook();
+		}
+		return;
+	}
+
+	Task *pTask = &scheduler_tasks[id];
+	if(pTask->function() == TASK_YIELD)
+	{
+		return;
+	}
+
+	pTask->ready = false;
+	pTask->runs++;
+
+	uint32_t lateness = sTimerGetTick() - pTask->release;
+	if(lateness > pTask->max_lateness)
+	{
+		pTask->max_lateness = lateness;
+	}
+	if(lateness > pTask->deadline)
+	{
+		pTask->misses++;
+	}
+}
+
+void schedulerReport()
+{
+	for(uint8_t id = 0; id < scheduler_count; id++)
+	{
+		rs232SendString((void*)scheduler_tasks[id].name);
+		rs232SendString((void*)" prio:");
+		rs232SendNum(scheduler_tasks[id].priority);
+		rs232SendString((void*)" runs:");
+		rs232SendNum(scheduler_tasks[id].runs);
+		rs232SendString((void*)" miss:");
+		rs232SendNum(scheduler_tasks[id].misses);
+		rs232SendString((void*)" max:");
+		rs232SendNum(scheduler_tasks[id].max_lateness);
+		rs232SendString((void*)"ms\r\n");
+	}
+}
+
+/**
+ * @brief	release every periodic task whose period elapsed, a release found still pending counts as a miss
+ */
+static void schedulerRelease(uint32_t now)
+{
+	for(uint8_t id = 0; id < scheduler_count; id++)
+	{
+		Task *pTask = &scheduler_tasks[id];
+		if(pTask->period == 0 || (int32_t)(now - pTask->next_release) < 0)
+		{
+			continue;
+		}
+
+		if(pTask->ready)
+		{
+			pTask->misses++;
+		}
+		else
+		{
+			pTask->release = pTask->next_release;
+			pTask->ready = true;
+		}
+
+		// keep the period phase, skip releases lost while the cpu was busy
+		do
+		{
+			pTask->next_release += pTask->period;
+		} while((int32_t)(now - pTask->next_release) >= 0);
+	}
+}
+
+static uint8_t schedulerPick()
+{
+	uint8_t best = SCHEDULER_NO_TASK;
+
+	for(uint8_t id = 0; id < scheduler_count; id++)
+	{
+		if(scheduler_tasks[id].ready
+				&& (best == SCHEDULER_NO_TASK || scheduler_tasks[id].priority < scheduler_tasks[best].priority))
+		{
+			best = id;
+		}
+	}
+	return best;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,207 @@
+/*
+ * spiBus.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "spiBus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initSPIBus(void);
+
+bool spiBusTransfer(uint16_t output, uint16_t *pInput);
+uint16_t spiBusGetInput(void);
+
+void spiBusStartStream(const volatile uint16_t *pFrames, uint16_t count, uint16_t period_us);
+bool spiBusIsStreaming(void);
+
+static void spiBusSetupStream(DMA_Stream_TypeDef *pStream, uint32_t config, volatile void *pPeripheral,
+		const volatile void *pMemory, uint16_t count);
+
+/* Variables */
+SPI_Bus_Stats spi_bus_stats;
+
+static volatile uint32_t spi_bus_owned = 0;
+static volatile uint16_t spi_bus_input = 0xffff; // buttons are active low, start with all released
+static bool spi_bus_streaming = false;
+
+/* BSRR words written by DMA in stream mode, DMA cannot read CCMRAM so they live in SRAM */
+static uint32_t spi_bus_latch_set;
+static uint32_t spi_bus_latch_reset;
+static uint32_t spi_bus_load_set;
+static uint32_t spi_bus_load_reset;
+static volatile uint16_t spi_bus_stream_input = 0xffff; // raw 16 bit frame, first byte in the high half
+
+/* Functions */
+/**
+ * @brief	put both shift register chains in their idle state, call after MX_SPI1_Init
+ */
+void initSPIBus()
+{
+	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 1);
+	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 1);
+}
+
+/**
+ * @brief	shift a word out to the display while shifting the button word in
+ * 			BTN_LOAD low-high samples the keys into the 74HC165 before the first clock,
+ * 			the rising edge of LD_LATCH after the last clock moves the new word to the 74HC595 outputs
+ * @param	output word for the display chain, low byte first
+ * @param	*pInput button word, may be NULL. left untouched if the transfer did not happen
+ * @retval	false if the bus was in use or the transfer failed
+ */
+bool spiBusTransfer(uint16_t output, uint16_t *pInput)
+{
+	uint16_t input;
+
+	// a context that preempts a transfer gives up instead of corrupting it
+	do
+	{
+		if(__LDREXW(&spi_bus_owned) != 0)
+		{
+			__CLREX();
+			spi_bus_stats.collisions++;
+			return false;
+		}
+	} while(__STREXW(1, &spi_bus_owned) != 0);
+	__DMB();
+
+	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 0);
+	HAL_GPIO_WritePin(BTN_LOAD_GPIO_Port, BTN_LOAD_Pin, 1);
+	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 0);
+	HAL_StatusTypeDef status = HAL_SPI_TransmitReceive(&hspi1, (void*)&output, (void*)&input, 2, SPI_BUS_TIMEOUT);
+	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 1);
+
+	spi_bus_stats.transfers++;
+	if(status == HAL_OK)
+	{
+		spi_bus_input = input;
+		if(pInput != NULL)
+		{
+			*pInput = input;
+		}
+	}
+	else
+	{
+		spi_bus_stats.errors++;
+	}
+
+	__DMB();
+	spi_bus_owned = 0;
+	return status == HAL_OK;
+}
+
+/**
+ * @brief	button word of the last successful transfer, bit clear if the key is down
+ */
+uint16_t spiBusGetInput()
+{
+	if(spi_bus_streaming)
+	{
+		// same byte order as a transfer of two 8 bit frames
+		return (uint16_t)__REV16(spi_bus_stream_input);
+	}
+	return spi_bus_input;
+}
+
+/**
+ * @brief	let TIM8 and DMA2 send frames over and over with no CPU work, the bus is never given back
+ * 			per period: update sends the next frame, LD_LATCH pulses after it, BTN_LOAD pulses before the next one
+ * @param	*pFrames words for the display chain, high byte is shifted first. may be edited while running
+ * @param	count number of frames in the cycle
+ * @param	period_us time between frames
+ */
+void spiBusStartStream(const volatile uint16_t *pFrames, uint16_t count, uint16_t period_us)
+{
+	uint32_t primask = __get_PRIMASK();
+
+	// wait for a transfer of this context to end, then keep the bus
+	while(1)
+	{
+		__disable_irq();
+		if(spi_bus_owned == 0)
+		{
+			spi_bus_owned = 1;
+			break;
+		}
+		__set_PRIMASK(primask);
+	}
+	spi_bus_streaming = true;
+	__set_PRIMASK(primask);
+
+	spi_bus_latch_set = LD_LATCH_Pin;
+	spi_bus_latch_reset = (uint32_t)LD_LATCH_Pin << 16;
+	spi_bus_load_set = BTN_LOAD_Pin;
+	spi_bus_load_reset = (uint32_t)BTN_LOAD_Pin << 16;
+	HAL_GPIO_WritePin(LD_LATCH_GPIO_Port, LD_LATCH_Pin, 0);
+
+	// 16 bit frames, written by DMA on the timer update instead of TXE, received by DMA on RXNE
+	hspi1.Init.DataSize = SPI_DATASIZE_16BIT;
+	(void)HAL_SPI_Init(&hspi1);
+	SET_BIT(hspi1.Instance->CR2, SPI_CR2_RXDMAEN);
+	__HAL_SPI_ENABLE(&hspi1);
+
+	__HAL_RCC_DMA2_CLK_ENABLE();
+	__HAL_RCC_TIM8_CLK_ENABLE();
+
+	DMA2->LIFCR = 0x0f7d0f7d; // clear every flag of streams 0-3
+	DMA2->HIFCR = 0x0f7d0f7d; // and 4-7
+
+	spiBusSetupStream(DMA2_Stream0, (3 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0,
+			&hspi1.Instance->DR, &spi_bus_stream_input, 1);														// SPI1_RX
+	spiBusSetupStream(DMA2_Stream1, (7 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 | DMA_SxCR_MINC | DMA_SxCR_MSIZE_0 | DMA_SxCR_PSIZE_0,
+			&hspi1.Instance->DR, pFrames, count);																// TIM8_UP
+	spiBusSetupStream(DMA2_Stream2, (7 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+			&LD_LATCH_GPIO_Port->BSRR, &spi_bus_latch_set, 1);													// TIM8_CH1
+	spiBusSetupStream(DMA2_Stream3, (7 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+			&LD_LATCH_GPIO_Port->BSRR, &spi_bus_latch_reset, 1);												// TIM8_CH2
+	spiBusSetupStream(DMA2_Stream4, (7 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+			&BTN_LOAD_GPIO_Port->BSRR, &spi_bus_load_reset, 1);													// TIM8_CH3
+	spiBusSetupStream(DMA2_Stream7, (7 << DMA_SxCR_CHSEL_Pos) | DMA_SxCR_DIR_0 | DMA_SxCR_MSIZE_1 | DMA_SxCR_PSIZE_1,
+			&BTN_LOAD_GPIO_Port->BSRR, &spi_bus_load_set, 1);													// TIM8_CH4
+
+	// TIM8 on APB2 runs at twice PCLK2 since APB2 is divided, count in us
+	TIM8->CR1 = 0;
+	TIM8->PSC = (HAL_RCC_GetPCLK2Freq() * 2) / 1000000 - 1;
+	TIM8->ARR = period_us - 1;
+	TIM8->CCR1 = SPI_BUS_LATCH_US;
+	TIM8->CCR2 = SPI_BUS_LATCH_END_US;
+	TIM8->CCR3 = period_us - SPI_BUS_LOAD_US;
+	TIM8->CCR4 = period_us - SPI_BUS_LOAD_END_US;
+	TIM8->EGR = TIM_EGR_UG; // load the prescaler now, the update request is enabled below
+	TIM8->SR = 0;
+	TIM8->DIER = TIM_DIER_UDE | TIM_DIER_CC1DE | TIM_DIER_CC2DE | TIM_DIER_CC3DE | TIM_DIER_CC4DE;
+	TIM8->CR1 = TIM_CR1_CEN;
+}
+
+bool spiBusIsStreaming()
+{
+	return spi_bus_streaming;
+}
+
+/**
+ * @brief	program one DMA2 stream in circular direct mode and enable it
+ */
+static void spiBusSetupStream(DMA_Stream_TypeDef *pStream, uint32_t config, volatile void *pPeripheral,
+		const volatile void *pMemory, uint16_t count)
+{
+	pStream->CR = 0;
+	while(pStream->CR & DMA_SxCR_EN)
+	{
+	}
+
+	pStream->PAR = (uint32_t)(uintptr_t)pPeripheral;
+	pStream->M0AR = (uint32_t)(uintptr_t)pMemory;
+	pStream->NDTR = count;
+	pStream->FCR = 0;
+	pStream->CR = config | DMA_SxCR_CIRC | DMA_SxCR_EN;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -22,6 +22,7 @@
 #include "stm32f4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "trace.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -206,11 +207,11 @@ void SysTick_Handler(void)
 void TIM2_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM2_IRQn 0 */
-
+  TRACE(TRACE_ISR_ENTER, TIM2_IRQn, 0);
   /* USER CODE END TIM2_IRQn 0 */
   HAL_TIM_IRQHandler(&htim2);
   /* USER CODE BEGIN TIM2_IRQn 1 */
-
+  TRACE(TRACE_ISR_EXIT, TIM2_IRQn, 0);
   /* USER CODE END TIM2_IRQn 1 */
 }
 
@@ -220,11 +221,11 @@ void TIM2_IRQHandler(void)
 void TIM4_IRQHandler(void)
 {
   /* USER CODE BEGIN TIM4_IRQn 0 */
-
+  TRACE(TRACE_ISR_ENTER, TIM4_IRQn, 0);
   /* USER CODE END TIM4_IRQn 0 */
   HAL_TIM_IRQHandler(&htim4);
   /* USER CODE BEGIN TIM4_IRQn 1 */
-
+  TRACE(TRACE_ISR_EXIT, TIM4_IRQn, 0);
   /* USER CODE END TIM4_IRQn 1 */
 }
 
@@ -234,11 +235,11 @@ void TIM4_IRQHandler(void)
 void USART1_IRQHandler(void)
 {
   /* USER CODE BEGIN USART1_IRQn 0 */
-
+  TRACE(TRACE_ISR_ENTER, USART1_IRQn, 0);
   /* USER CODE END USART1_IRQn 0 */
   HAL_UART_IRQHandler(&huart1);
   /* USER CODE BEGIN USART1_IRQn 1 */
-
+  TRACE(TRACE_ISR_EXIT, USART1_IRQn, 0);
   /* USER CODE END USART1_IRQn 1 */
 }
 
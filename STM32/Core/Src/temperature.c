@@ -0,0 +1,259 @@
+/*
+ * temperature.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "temperature.h"
+#include "ds3231.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initTemperature(void);
+
+void temperatureRequest(void);
+bool temperatureProcess(void);
+bool temperatureIsValid(void);
+
+void temperatureGetStats(Temp_Stats *pStats);
+int16_t temperatureGetLatest(void);
+
+void temperatureReport(void);
+
+static void temperaturePush(int16_t sample);
+static void temperatureSend(int16_t temperature);
+
+/* Variables */
+static Temp_State temp_state = TEMP_IDLE;
+static bool temp_requested = false;
+static uint8_t temp_timeout = 0;
+
+static int16_t temp_history[TEMP_HISTORY_SIZE];
+static uint32_t temp_sample_index = 0; // total number of samples pushed, history slot is index % TEMP_HISTORY_SIZE
+static int32_t temp_sum = 0;
+
+/* monotonic wedges hold sample indexes, front is the min (max) of the current window */
+static uint32_t temp_min_wedge[TEMP_HISTORY_SIZE];
+static uint32_t temp_max_wedge[TEMP_HISTORY_SIZE];
+static uint8_t temp_min_head = 0, temp_min_size = 0;
+static uint8_t temp_max_head = 0, temp_max_size = 0;
+
+/* Functions */
+/**
+ * @brief	init temperature pipeline, clear history
+ */
+void initTemperature()
+{
+	temp_state = TEMP_IDLE;
+	temp_requested = false;
+	temp_sample_index = 0;
+	temp_sum = 0;
+	temp_min_head = temp_min_size = 0;
+	temp_max_head = temp_max_size = 0;
+}
+
+/**
+ * @brief	ask for a forced conversion, it is started by the next temperatureProcess() calls
+ */
+void temperatureRequest()
+{
+	temp_requested = true;
+}
+
+/**
+ * @brief	advance the conversion state machine by one step, never wait for ds3231
+ * @note	call periodically (e.g. every 50ms), each call does at most one short i2c transaction
+ * 			except when the conversion is started
+ * @retval	true if a new sample is pushed into history
+ */
+bool temperatureProcess()
+{
+	uint8_t reg[5]; // control, status, aging, temp msb, temp lsb
+
+	switch (temp_state)
+	{
+		case TEMP_IDLE:
+		{
+			if(temp_requested)
+			{
+				temp_requested = false;
+				temp_timeout = TEMP_CONV_TIMEOUT;
+				temp_state = TEMP_WAIT_READY;
+			}
+			return false;
+		}
+		case TEMP_WAIT_READY:
+		{
+			if(!ds3231ReadBurst(DS3231_REG_STATUS, reg, 1) || temp_timeout-- == 0)
+			{
+				temp_state = TEMP_IDLE;
+				return false;
+			}
+			if((reg[0] >> DS3231_BSY) & 0x01)
+			{
+				return false; // an automatic conversion is running, try again next call
+			}
+			if(ds3231StartConversion())
+			{
+				temp_timeout = TEMP_CONV_TIMEOUT;
+				temp_state = TEMP_CONVERTING;
+			}
+			return false;
+		}
+		case TEMP_CONVERTING:
+		{
+			// readiness and result come in the same transaction
+			if(!ds3231ReadBurst(DS3231_REG_CONTROL, reg, 5) || temp_timeout-- == 0)
+			{
+				temp_state = TEMP_IDLE;
+				return false;
+			}
+			if(((reg[0] >> DS3231_CONV) & 0x01) || ((reg[1] >> DS3231_BSY) & 0x01))
+			{
+				return false;
+			}
+			temperaturePush(ds3231DecodeTemp(reg[3], reg[4]));
+			temp_state = TEMP_IDLE;
+			return true;
+		}
+		default:
+		{
+			temp_state = TEMP_IDLE;
+			return false;
+		}
+	}
+}
+
+/**
+ * @brief	insert a sample into the ring and update running sum, min and max wedges
+ * @note	amortized O(1): every index is pushed to and popped from each wedge at most once
+ */
+static void temperaturePush(int16_t sample)
+{
+	uint32_t index = temp_sample_index;
+	uint8_t slot = index % TEMP_HISTORY_SIZE;
+
+	if(index >= TEMP_HISTORY_SIZE)
+	{
+		// drop the oldest sample out of the window
+		uint32_t oldest = index - TEMP_HISTORY_SIZE;
+		temp_sum -= temp_history[slot];
+		if(temp_min_size && temp_min_wedge[temp_min_head] == oldest)
+		{
+			temp_min_head = (temp_min_head + 1) % TEMP_HISTORY_SIZE;
+			temp_min_size--;
+		}
+		if(temp_max_size && temp_max_wedge[temp_max_head] == oldest)
+		{
+			temp_max_head = (temp_max_head + 1) % TEMP_HISTORY_SIZE;
+			temp_max_size--;
+		}
+	}
+
+	temp_history[slot] = sample;
+	temp_sum += sample;
+
+	while(temp_min_size && temp_history[temp_min_wedge[(temp_min_head + temp_min_size - 1) % TEMP_HISTORY_SIZE] % TEMP_HISTORY_SIZE] >= sample)
+	{
+		temp_min_size--;
+	}
+	temp_min_wedge[(temp_min_head + temp_min_size) % TEMP_HISTORY_SIZE] = index;
+	temp_min_size++;
+
+	while(temp_max_size && temp_history[temp_max_wedge[(temp_max_head + temp_max_size - 1) % TEMP_HISTORY_SIZE] % TEMP_HISTORY_SIZE] <= sample)
+	{
+		temp_max_size--;
+	}
+	temp_max_wedge[(temp_max_head + temp_max_size) % TEMP_HISTORY_SIZE] = index;
+	temp_max_size++;
+
+	temp_sample_index = index + 1;
+}
+
+/**
+ * @retval	true if at least one sample has been read
+ */
+bool temperatureIsValid()
+{
+	return temp_sample_index != 0;
+}
+
+/**
+ * @retval	latest temperature in quarter degree Celsius
+ */
+int16_t temperatureGetLatest()
+{
+	if(temp_sample_index == 0)
+	{
+		return 0;
+	}
+	return temp_history[(temp_sample_index - 1) % TEMP_HISTORY_SIZE];
+}
+
+/**
+ * @brief	get latest, min, max and mean (rounded) of the samples in history, O(1)
+ * @param	*pStats pointer to struct to store into, all value in quarter degree Celsius
+ */
+void temperatureGetStats(Temp_Stats *pStats)
+{
+	uint8_t count = (temp_sample_index < TEMP_HISTORY_SIZE) ? temp_sample_index : TEMP_HISTORY_SIZE;
+
+	pStats->count = count;
+	if(count == 0)
+	{
+		pStats->latest = pStats->min = pStats->max = pStats->mean = 0;
+		return;
+	}
+	pStats->latest = temperatureGetLatest();
+	pStats->min = temp_history[temp_min_wedge[temp_min_head] % TEMP_HISTORY_SIZE];
+	pStats->max = temp_history[temp_max_wedge[temp_max_head] % TEMP_HISTORY_SIZE];
+	pStats->mean = (temp_sum >= 0) ? (temp_sum + count / 2) / count : (temp_sum - count / 2) / count;
+}
+
+/**
+ * @brief	send the statistic of the samples in history over rs232
+ */
+void temperatureReport()
+{
+	Temp_Stats stats;
+
+	temperatureGetStats(&stats);
+	rs232SendString((void*)"Temp n:");
+	rs232SendNum(stats.count);
+	if(stats.count > 0)
+	{
+		rs232SendString((void*)" latest:");
+		temperatureSend(stats.latest);
+		rs232SendString((void*)" min:");
+		temperatureSend(stats.min);
+		rs232SendString((void*)" max:");
+		temperatureSend(stats.max);
+		rs232SendString((void*)" mean:");
+		temperatureSend(stats.mean);
+	}
+	rs232SendString((void*)"\r\n");
+}
+
+/**
+ * @brief	send a quarter degree temperature as [-]x.xxC
+ */
+static void temperatureSend(int16_t temperature)
+{
+	uint16_t abs_temp = (temperature < 0) ? -temperature : temperature;
+
+	if(temperature < 0)
+	{
+		rs232SendString((void*)"-");
+	}
+	rs232SendNumPercent((uint32_t)abs_temp * 25);
+	rs232SendString((void*)"C");
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
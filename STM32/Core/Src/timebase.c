@@ -0,0 +1,107 @@
+/*
+ * timebase.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "timebase.h"
+#include "tim.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initTimebase(void);
+
+uint64_t timebaseGetUs(void);
+uint32_t timebaseGetUs32(void);
+uint64_t timebaseElapsedUs(uint64_t since);
+void timebaseDelayUs(uint32_t us);
+bool timebaseTimeout(uint64_t start, uint32_t timeout_us);
+
+void timebaseOverflow(void);
+
+/* Variables */
+static volatile uint32_t timebase_high = 0; // number of TIM2 wraps, upper 32 bit of the timestamp
+
+/* Functions */
+/**
+ * @brief	start TIM2 free running over its full 32 bit range, update interrupt only on wrap (~71 minutes)
+ */
+void initTimebase()
+{
+	timebase_high = 0;
+	__HAL_TIM_SET_COUNTER(&htim2, 0);
+	HAL_TIM_Base_Start_IT(&htim2);
+}
+
+/**
+ * @brief	64 bit microsecond timestamp, lock free and safe from any context.
+ * 			a wrap not yet counted by the ISR (interrupts masked or a higher priority caller)
+ * 			is detected from the pending update flag, a wrap counted during the read forces a retry.
+ */
+uint64_t timebaseGetUs()
+{
+	uint32_t high;
+	uint32_t low;
+	uint32_t wraps;
+
+	do
+	{
+		high = timebase_high;
+		low = TIM2->CNT;
+		wraps = high;
+		if((TIM2->SR & TIM_SR_UIF) && low < 0x80000000u)
+		{
+			wraps++;
+		}
+	} while(high != timebase_high);
+
+	return ((uint64_t)wraps << 32) | low;
+}
+
+/**
+ * @brief	low 32 bit of the timestamp, a single register read, differences are valid for ~71 minutes
+ */
+uint32_t timebaseGetUs32()
+{
+	return TIM2->CNT;
+}
+
+uint64_t timebaseElapsedUs(uint64_t since)
+{
+	return timebaseGetUs() - since;
+}
+
+/**
+ * @brief	busy wait
+ */
+void timebaseDelayUs(uint32_t us)
+{
+	uint32_t start = TIM2->CNT;
+	while((uint32_t)(TIM2->CNT - start) < us)
+	{
+	}
+}
+
+/**
+ * @retval	true once timeout_us passed since start
+ */
+bool timebaseTimeout(uint64_t start, uint32_t timeout_us)
+{
+	return timebaseElapsedUs(start) >= timeout_us;
+}
+
+/**
+ * @brief	called from TIM2 update interrupt
+ */
+void timebaseOverflow()
+{
+	timebase_high++;
+}
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
@@ -0,0 +1,141 @@
+/*
+ * trace.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#include "trace.h"
+#include "main.h"
+#include "rs232_uart.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif /* __cplusplus */
+
+void initTrace(void);
+
+void traceRecord(Trace_Event id, uint16_t arg0, uint32_t arg1);
+void traceClear(void);
+
+void traceDump(void);
+
+#ifdef TRACE_ENABLE
+
+typedef struct
+{
+	uint32_t magic;
+	volatile uint32_t head;		// records written since the ring was cleared, not wrapped
+	Trace_Record records[TRACE_SIZE];
+}Trace_Ring;
+
+/* Variables */
+static Trace_Ring trace_ring __attribute__((section(".ccmram")));
+static volatile bool trace_paused = false;
+
+/* Functions */
+/**
+ * @brief	keep the ring of the previous run if it is valid, then mark the reset. call after initTimebase
+ */
+void initTrace()
+{
+	if(trace_ring.magic != TRACE_MAGIC)
+	{
+		traceClear();
+	}
+	traceRecord(TRACE_RESET, TRACE_VERSION, 0);
+}
+
+/**
+ * @brief	append one record, safe from any interrupt priority
+ * 			the slot is claimed with LDREX/STREX so a preempting interrupt takes the next one
+ */
+void traceRecord(Trace_Event id, uint16_t arg0, uint32_t arg1)
+{
+	uint32_t index;
+	uint32_t timestamp;
+
+	if(trace_paused)
+	{
+		return;
+	}
+
+	// the timestamp is read inside the claim, an interrupt in between clears the exclusive monitor
+	// and the retry reads it again, so records are in timestamp order
+	do
+	{
+		index = __LDREXW(&trace_ring.head);
+		timestamp = TIM2->CNT; // timebaseGetUs32 without the call
+	} while(__STREXW(index + 1, &trace_ring.head) != 0);
+
+	Trace_Record *pRecord = &trace_ring.records[index & TRACE_MASK];
+	pRecord->timestamp = timestamp;
+	pRecord->id = id;
+	pRecord->arg0 = arg0;
+	pRecord->arg1 = arg1;
+}
+
+void traceClear()
+{
+	trace_ring.head = 0;
+	trace_ring.magic = TRACE_MAGIC;
+}
+
+/**
+ * @brief	send the ring oldest first over rs232, recording is paused meanwhile
+ * 			format: "TRACE v<version> n:<records> lost:<overwritten>\r\n", the records as raw
+ * 			little endian Trace_Record, then "\r\nTRACE END\r\n". takes about 1ms per record at 115200 baud
+ */
+void traceDump()
+{
+	trace_paused = true;
+
+	uint32_t head = trace_ring.head;
+	uint32_t count = (head < TRACE_SIZE) ? head : TRACE_SIZE;
+
+	rs232SendString((void*)"TRACE v");
+	rs232SendNum(TRACE_VERSION);
+	rs232SendString((void*)" n:");
+	rs232SendNum(count);
+	rs232SendString((void*)" lost:");
+	rs232SendNum(head - count);
+	rs232SendString((void*)"\r\n");
+
+	for(uint32_t index = head - count; index != head; index++)
+	{
+		rs232SendBytes((uint8_t*)&trace_ring.records[index & TRACE_MASK], sizeof(Trace_Record));
+	}
+
+	rs232SendString((void*)"\r\nTRACE END\r\n");
+
+	trace_paused = false;
+}
+
+#else
+
+void initTrace()
+{
+}
+
+void traceRecord(Trace_Event id, uint16_t arg0, uint32_t arg1)
+{
+	(void)id;
+	(void)arg0;
+	(void)arg1;
+}
+
+void traceClear()
+{
+}
+
+void traceDump()
+{
+	rs232SendString((void*)"Trace disabled, build with TRACE_ENABLE\r\n");
+}
+
+#endif /* TRACE_ENABLE */
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
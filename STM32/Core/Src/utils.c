@@ -6,6 +6,8 @@
  */
 
 #include "utils.h"
+#include "main.h"
+#include "rs232_uart.h"
 #include <stdlib.h>
 
 #ifdef __cplusplus
@@ -16,6 +18,12 @@ extern "C"
 uint8_t BCD2DEC(uint8_t data);
 uint8_t DEC2BCD(uint8_t data);
 
+void initCycleCounter(void);
+uint32_t getCycleCounter(void);
+
+uint8_t histogramBucket(uint32_t value, uint8_t shift, uint8_t size);
+void histogramReport(const uint32_t *histogram, uint8_t shift, uint8_t size);
+
 /**
  * @brief: transform splited 8 bit (4 bit MSB represent tens and 4 bit LSB represent units) to decimal
  * @param: splited 8 bit
@@ -34,6 +42,68 @@ uint8_t DEC2BCD(uint8_t data)
 	return (data / 10) << 4 | (data % 10);
 }
 
+/**
+ * @brief	enable DWT cycle counter, counts core clock cycles (168MHz) and wraps every ~25s
+ * @note	counter is not cleared, several modules call this and keep their own start values
+ */
+void initCycleCounter()
+{
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+/**
+ * @brief	get current value of DWT cycle counter, difference of 2 values is valid across wrap
+ */
+uint32_t getCycleCounter()
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief	bucket of a log2 histogram: bucket 0 < 1 << shift, bucket n < (1 << shift) << n, the last bucket collects the rest
+ * @retval	0 to size - 1
+ */
+uint8_t histogramBucket(uint32_t value, uint8_t shift, uint8_t size)
+{
+	uint8_t bucket = 0;
+
+	value >>= shift;
+	while(value != 0 && bucket < size - 1)
+	{
+		value >>= 1;
+		bucket++;
+	}
+	return bucket;
+}
+
+/**
+ * @brief	send the non empty buckets of a histogram filled by histogramBucket over rs232, one line each
+ */
+void histogramReport(const uint32_t *histogram, uint8_t shift, uint8_t size)
+{
+	for(uint8_t bucket = 0; bucket < size; bucket++)
+	{
+		if(histogram[bucket] == 0)
+		{
+			continue;
+		}
+		if(bucket < size - 1)
+		{
+			rs232SendString((void*)"  <");
+			rs232SendNum((1UL << shift) << bucket);
+		}
+		else
+		{
+			rs232SendString((void*)"  >=");
+			rs232SendNum((1UL << shift) << (bucket - 1));
+		}
+		rs232SendString((void*)"us: ");
+		rs232SendNum(histogram[bucket]);
+		rs232SendString((void*)"\r\n");
+	}
+}
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -5,68 +5,113 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Core/Src/alarm.c \
 ../Core/Src/button.c \
 ../Core/Src/dataStructure.c \
+../Core/Src/deadline.c \
 ../Core/Src/ds3231.c \
+../Core/Src/ds3231Sim.c \
+../Core/Src/epoch.c \
+../Core/Src/event.c \
 ../Core/Src/fsmc.c \
 ../Core/Src/gpio.c \
 ../Core/Src/i2c.c \
+../Core/Src/i2cBus.c \
+../Core/Src/keymap.c \
+../Core/Src/latency.c \
 ../Core/Src/lcd.c \
 ../Core/Src/led7Seg.c \
 ../Core/Src/main.c \
+../Core/Src/power.c \
+../Core/Src/profiler.c \
 ../Core/Src/rs232_uart.c \
 ../Core/Src/sTimer.c \
+../Core/Src/scheduler.c \
 ../Core/Src/spi.c \
+../Core/Src/spiBus.c \
 ../Core/Src/stm32f4xx_hal_msp.c \
 ../Core/Src/stm32f4xx_it.c \
 ../Core/Src/syscalls.c \
 ../Core/Src/sysmem.c \
 ../Core/Src/system_stm32f4xx.c \
+../Core/Src/temperature.c \
 ../Core/Src/tim.c \
+../Core/Src/timebase.c \
+../Core/Src/trace.c \
 ../Core/Src/usart.c \
 ../Core/Src/utils.c 
 
 OBJS += \
+./Core/Src/alarm.o \
 ./Core/Src/button.o \
 ./Core/Src/dataStructure.o \
+./Core/Src/deadline.o \
 ./Core/Src/ds3231.o \
+./Core/Src/ds3231Sim.o \
+./Core/Src/epoch.o \
+./Core/Src/event.o \
 ./Core/Src/fsmc.o \
 ./Core/Src/gpio.o \
 ./Core/Src/i2c.o \
+./Core/Src/i2cBus.o \
+./Core/Src/keymap.o \
+./Core/Src/latency.o \
 ./Core/Src/lcd.o \
 ./Core/Src/led7Seg.o \
 ./Core/Src/main.o \
+./Core/Src/power.o \
+./Core/Src/profiler.o \
 ./Core/Src/rs232_uart.o \
 ./Core/Src/sTimer.o \
+./Core/Src/scheduler.o \
 ./Core/Src/spi.o \
+./Core/Src/spiBus.o \
 ./Core/Src/stm32f4xx_hal_msp.o \
 ./Core/Src/stm32f4xx_it.o \
 ./Core/Src/syscalls.o \
 ./Core/Src/sysmem.o \
 ./Core/Src/system_stm32f4xx.o \
+./Core/Src/temperature.o \
 ./Core/Src/tim.o \
+./Core/Src/timebase.o \
+./Core/Src/trace.o \
 ./Core/Src/usart.o \
 ./Core/Src/utils.o 
 
 C_DEPS += \
+./Core/Src/alarm.d \
 ./Core/Src/button.d \
 ./Core/Src/dataStructure.d \
+./Core/Src/deadline.d \
 ./Core/Src/ds3231.d \
+./Core/Src/ds3231Sim.d \
+./Core/Src/epoch.d \
+./Core/Src/event.d \
 ./Core/Src/fsmc.d \
 ./Core/Src/gpio.d \
 ./Core/Src/i2c.d \
+./Core/Src/i2cBus.d \
+./Core/Src/keymap.d \
+./Core/Src/latency.d \
 ./Core/Src/lcd.d \
 ./Core/Src/led7Seg.d \
 ./Core/Src/main.d \
+./Core/Src/power.d \
+./Core/Src/profiler.d \
 ./Core/Src/rs232_uart.d \
 ./Core/Src/sTimer.d \
+./Core/Src/scheduler.d \
 ./Core/Src/spi.d \
+./Core/Src/spiBus.d \
 ./Core/Src/stm32f4xx_hal_msp.d \
 ./Core/Src/stm32f4xx_it.d \
 ./Core/Src/syscalls.d \
 ./Core/Src/sysmem.d \
 ./Core/Src/system_stm32f4xx.d \
+./Core/Src/temperature.d \
 ./Core/Src/tim.d \
+./Core/Src/timebase.d \
+./Core/Src/trace.d \
 ./Core/Src/usart.d \
 ./Core/Src/utils.d 
 
@@ -78,7 +123,7 @@ Core/Src/%.o Core/Src/%.su Core/Src/%.cyclo: ../Core/Src/%.c Core/Src/subdir.mk
 clean: clean-Core-2f-Src
 
 clean-Core-2f-Src:
-	-$(RM) ./Core/Src/button.cyclo ./Core/Src/button.d ./Core/Src/button.o ./Core/Src/button.su ./Core/Src/dataStructure.cyclo ./Core/Src/dataStructure.d ./Core/Src/dataStructure.o ./Core/Src/dataStructure.su ./Core/Src/ds3231.cyclo ./Core/Src/ds3231.d ./Core/Src/ds3231.o ./Core/Src/ds3231.su ./Core/Src/fsmc.cyclo ./Core/Src/fsmc.d ./Core/Src/fsmc.o ./Core/Src/fsmc.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/i2c.cyclo ./Core/Src/i2c.d ./Core/Src/i2c.o ./Core/Src/i2c.su ./Core/Src/lcd.cyclo ./Core/Src/lcd.d ./Core/Src/lcd.o ./Core/Src/lcd.su ./Core/Src/led7Seg.cyclo ./Core/Src/led7Seg.d ./Core/Src/led7Seg.o ./Core/Src/led7Seg.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/rs232_uart.cyclo ./Core/Src/rs232_uart.d ./Core/Src/rs232_uart.o ./Core/Src/rs232_uart.su ./Core/Src/sTimer.cyclo ./Core/Src/sTimer.d ./Core/Src/sTimer.o ./Core/Src/sTimer.su ./Core/Src/spi.cyclo ./Core/Src/spi.d ./Core/Src/spi.o ./Core/Src/spi.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su ./Core/Src/utils.cyclo ./Core/Src/utils.d ./Core/Src/utils.o ./Core/Src/utils.su
+	-$(RM) ./Core/Src/alarm.cyclo ./Core/Src/alarm.d ./Core/Src/alarm.o ./Core/Src/alarm.su ./Core/Src/button.cyclo ./Core/Src/button.d ./Core/Src/button.o ./Core/Src/button.su ./Core/Src/dataStructure.cyclo ./Core/Src/dataStructure.d ./Core/Src/dataStructure.o ./Core/Src/dataStructure.su ./Core/Src/deadline.cyclo ./Core/Src/deadline.d ./Core/Src/deadline.o ./Core/Src/deadline.su ./Core/Src/ds3231.cyclo ./Core/Src/ds3231.d ./Core/Src/ds3231.o ./Core/Src/ds3231.su ./Core/Src/ds3231Sim.cyclo ./Core/Src/ds3231Sim.d ./Core/Src/ds3231Sim.o ./Core/Src/ds3231Sim.su ./Core/Src/epoch.cyclo ./Core/Src/epoch.d ./Core/Src/epoch.o ./Core/Src/epoch.su ./Core/Src/event.cyclo ./Core/Src/event.d ./Core/Src/event.o ./Core/Src/event.su ./Core/Src/fsmc.cyclo ./Core/Src/fsmc.d ./Core/Src/fsmc.o ./Core/Src/fsmc.su ./Core/Src/gpio.cyclo ./Core/Src/gpio.d ./Core/Src/gpio.o ./Core/Src/gpio.su ./Core/Src/i2c.cyclo ./Core/Src/i2c.d ./Core/Src/i2c.o ./Core/Src/i2c.su ./Core/Src/i2cBus.cyclo ./Core/Src/i2cBus.d ./Core/Src/i2cBus.o ./Core/Src/i2cBus.su ./Core/Src/keymap.cyclo ./Core/Src/keymap.d ./Core/Src/keymap.o ./Core/Src/keymap.su ./Core/Src/latency.cyclo ./Core/Src/latency.d ./Core/Src/latency.o ./Core/Src/latency.su ./Core/Src/lcd.cyclo ./Core/Src/lcd.d ./Core/Src/lcd.o ./Core/Src/lcd.su ./Core/Src/led7Seg.cyclo ./Core/Src/led7Seg.d ./Core/Src/led7Seg.o ./Core/Src/led7Seg.su ./Core/Src/main.cyclo ./Core/Src/main.d ./Core/Src/main.o ./Core/Src/main.su ./Core/Src/power.cyclo ./Core/Src/power.d ./Core/Src/power.o ./Core/Src/power.su ./Core/Src/profiler.cyclo ./Core/Src/profiler.d ./Core/Src/profiler.o ./Core/Src/profiler.su ./Core/Src/rs232_uart.cyclo ./Core/Src/rs232_uart.d ./Core/Src/rs232_uart.o ./Core/Src/rs232_uart.su ./Core/Src/sTimer.cyclo ./Core/Src/sTimer.d ./Core/Src/sTimer.o ./Core/Src/sTimer.su ./Core/Src/scheduler.cyclo ./Core/Src/scheduler.d ./Core/Src/scheduler.o ./Core/Src/scheduler.su ./Core/Src/spi.cyclo ./Core/Src/spi.d ./Core/Src/spi.o ./Core/Src/spi.su ./Core/Src/spiBus.cyclo ./Core/Src/spiBus.d ./Core/Src/spiBus.o ./Core/Src/spiBus.su ./Core/Src/stm32f4xx_hal_msp.cyclo ./Core/Src/stm32f4xx_hal_msp.d ./Core/Src/stm32f4xx_hal_msp.o ./Core/Src/stm32f4xx_hal_msp.su ./Core/Src/stm32f4xx_it.cyclo ./Core/Src/stm32f4xx_it.d ./Core/Src/stm32f4xx_it.o ./Core/Src/stm32f4xx_it.su ./Core/Src/syscalls.cyclo ./Core/Src/syscalls.d ./Core/Src/syscalls.o ./Core/Src/syscalls.su ./Core/Src/sysmem.cyclo ./Core/Src/sysmem.d ./Core/Src/sysmem.o ./Core/Src/sysmem.su ./Core/Src/system_stm32f4xx.cyclo ./Core/Src/system_stm32f4xx.d ./Core/Src/system_stm32f4xx.o ./Core/Src/system_stm32f4xx.su ./Core/Src/temperature.cyclo ./Core/Src/temperature.d ./Core/Src/temperature.o ./Core/Src/temperature.su ./Core/Src/tim.cyclo ./Core/Src/tim.d ./Core/Src/tim.o ./Core/Src/tim.su ./Core/Src/timebase.cyclo ./Core/Src/timebase.d ./Core/Src/timebase.o ./Core/Src/timebase.su ./Core/Src/trace.cyclo ./Core/Src/trace.d ./Core/Src/trace.o ./Core/Src/trace.su ./Core/Src/usart.cyclo ./Core/Src/usart.d ./Core/Src/usart.o ./Core/Src/usart.su ./Core/Src/utils.cyclo ./Core/Src/utils.d ./Core/Src/utils.o ./Core/Src/utils.su
 
 .PHONY: clean-Core-2f-Src
 
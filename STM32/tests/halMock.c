@@ -0,0 +1,70 @@
+/*
+ * halMock.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Core registers, timebase, sTimer tick, spi input and rs232 of a host test,
+ * every value is set by the test instead of a peripheral.
+ */
+
+#include "timebase.h"
+#include "sTimer.h"
+#include "spiBus.h"
+#include "rs232_uart.h"
+#include <string.h>
+
+/* Variables */
+uint32_t SystemCoreClock = 168000000;
+GPIO_TypeDef mock_gpiob;
+DWT_Type mock_dwt;
+CoreDebug_Type mock_core_debug;
+
+uint32_t mock_time_us = 0;
+uint32_t mock_tick = 0;
+uint16_t mock_spi_input = 0xffff;
+char mock_rs232_output[1024];
+
+/* Functions */
+uint32_t timebaseGetUs32()
+{
+	return mock_time_us;
+}
+
+uint64_t timebaseGetUs()
+{
+	return mock_time_us;
+}
+
+void timebaseDelayUs(uint32_t us)
+{
+	mock_time_us += us;
+}
+
+uint32_t sTimerGetTick()
+{
+	return mock_tick;
+}
+
+uint16_t spiBusGetInput()
+{
+	return mock_spi_input;
+}
+
+void mockRS232Clear()
+{
+	mock_rs232_output[0] = '\0';
+}
+
+void rs232SendString(uint8_t *str)
+{
+	strncat(mock_rs232_output, (char*)str, sizeof(mock_rs232_output) - strlen(mock_rs232_output) - 1);
+}
+
+void rs232SendNum(uint32_t num)
+{
+	char text[11];
+
+	snprintf(text, sizeof(text), "%lu", (unsigned long)num);
+	rs232SendString((uint8_t*)text);
+}
@@ -0,0 +1,119 @@
+/*
+ * halMock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Forced in front of every file of a host test (gcc -include). The include guards of the
+ * CubeMX headers are taken so the STM32 HAL is never seen, the few HAL and CMSIS names the
+ * tested modules use are declared here and implemented in halMock.c and i2cMock.c.
+ */
+
+#ifndef TESTS_HALMOCK_H_
+#define TESTS_HALMOCK_H_
+
+/* Includes */
+#include <stdint.h>
+
+#define __MAIN_H
+#define __I2C_H__
+#define __SPI_H__
+#define __USART_H__
+
+/* Private define */
+#define GPIO_PIN_6					((uint16_t)0x0040)
+#define GPIO_PIN_7					((uint16_t)0x0080)
+#define GPIO_MODE_OUTPUT_OD			0x00000011U
+#define GPIO_NOPULL					0x00000000U
+#define GPIO_SPEED_FREQ_VERY_HIGH	0x00000003U
+#define GPIOB						(&mock_gpiob)
+
+#define I2C_MEMADD_SIZE_8BIT		0x00000001U
+#define I2C_FLAG_BUSY				0x00100002U
+#define HAL_I2C_ERROR_AF			0x00000004U
+#define __HAL_I2C_GET_FLAG(handle, flag)	0
+
+#define DWT							(&mock_dwt)
+#define CoreDebug					(&mock_core_debug)
+#define DWT_CTRL_CYCCNTENA_Msk		(1UL << 0)
+#define CoreDebug_DEMCR_TRCENA_Msk	(1UL << 24)
+
+#define __DMB()						__sync_synchronize()
+#define __CLZ(value)				((uint8_t)__builtin_clz(value))
+#define __get_PRIMASK()				0U
+#define __set_PRIMASK(primask)		((void)(primask))
+#define __disable_irq()				((void)0)
+
+typedef enum
+{
+	HAL_OK = 0x00U,
+	HAL_ERROR = 0x01U,
+	HAL_BUSY = 0x02U,
+	HAL_TIMEOUT = 0x03U
+}HAL_StatusTypeDef;
+
+typedef enum
+{
+	GPIO_PIN_RESET = 0,
+	GPIO_PIN_SET
+}GPIO_PinState;
+
+typedef struct
+{
+	uint32_t Pin;
+	uint32_t Mode;
+	uint32_t Pull;
+	uint32_t Speed;
+	uint32_t Alternate;
+}GPIO_InitTypeDef;
+
+typedef struct
+{
+	uint32_t ODR;
+}GPIO_TypeDef;
+
+typedef struct
+{
+	uint32_t ErrorCode;
+}I2C_HandleTypeDef;
+
+typedef struct
+{
+	volatile uint32_t CTRL;
+	volatile uint32_t CYCCNT;
+}DWT_Type;
+
+typedef struct
+{
+	volatile uint32_t DEMCR;
+}CoreDebug_Type;
+
+/* Variables */
+extern uint32_t SystemCoreClock;
+extern GPIO_TypeDef mock_gpiob;
+extern DWT_Type mock_dwt;
+extern CoreDebug_Type mock_core_debug;
+extern I2C_HandleTypeDef hi2c1;
+
+extern uint32_t mock_time_us;		// timebaseGetUs32
+extern uint32_t mock_tick;			// sTimerGetTick
+extern uint16_t mock_spi_input;		// spiBusGetInput, a key reads 0 while pressed
+extern char mock_rs232_output[1024];	// everything sent over rs232 since mockRS232Clear
+
+/* Functions */
+void mockRS232Clear(void);
+
+void MX_I2C1_Init(void);
+HAL_StatusTypeDef HAL_I2C_DeInit(I2C_HandleTypeDef *hi2c);
+HAL_StatusTypeDef HAL_I2C_Mem_Read(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+		uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_Mem_Write(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint16_t MemAddress,
+		uint16_t MemAddSize, uint8_t *pData, uint16_t Size, uint32_t Timeout);
+HAL_StatusTypeDef HAL_I2C_IsDeviceReady(I2C_HandleTypeDef *hi2c, uint16_t DevAddress, uint32_t Trials, uint32_t Timeout);
+uint32_t HAL_I2C_GetError(I2C_HandleTypeDef *hi2c);
+
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin);
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState);
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init);
+
+#endif /* TESTS_HALMOCK_H_ */
@@ -0,0 +1,28 @@
+/*
+ * i2cMock.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ */
+
+#ifndef TESTS_I2CMOCK_H_
+#define TESTS_I2CMOCK_H_
+
+/* Includes */
+#include <stdint.h>
+
+typedef struct
+{
+	uint32_t reads;		// HAL_I2C_Mem_Read calls
+	uint32_t writes;	// HAL_I2C_Mem_Write calls
+	uint32_t probes;	// HAL_I2C_IsDeviceReady calls
+}I2C_Mock_Stats;
+
+/* Variables */
+extern I2C_Mock_Stats i2c_mock_stats;
+
+/* Functions */
+void i2cMockReset(void);
+uint32_t i2cMockTransactions(void);
+
+#endif /* TESTS_I2CMOCK_H_ */
@@ -0,0 +1,38 @@
+/*
+ * test.h
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * Checks of a host test, include once from the file holding main().
+ */
+
+#ifndef TESTS_TEST_H_
+#define TESTS_TEST_H_
+
+/* Includes */
+#include <stdio.h>
+
+/* Variables */
+static int test_checks = 0;
+static int test_failures = 0;
+
+/* a failed check is printed and counted, the test goes on */
+#define TEST_CHECK(condition)	do { test_checks++; if(!(condition)) { \
+		printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); test_failures++; } } while(0)
+
+#define TEST_EQUAL(actual, expected)	do { test_checks++; long long test_actual = (long long)(actual); \
+		long long test_expected = (long long)(expected); if(test_actual != test_expected) { \
+		printf("%s:%d: %s is %lld, expected %lld\n", __FILE__, __LINE__, #actual, test_actual, test_expected); \
+		test_failures++; } } while(0)
+
+/**
+ * @retval	exit status of the test: 0 if every check passed
+ */
+static inline int testSummary(const char *name)
+{
+	printf("%s: %d checks, %d failed\n", name, test_checks, test_failures);
+	return (test_failures == 0) ? 0 : 1;
+}
+
+#endif /* TESTS_TEST_H_ */
@@ -0,0 +1,216 @@
+/*
+ * testDs3231.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * ds3231 driver through the i2c bus layer against the register model behind the HAL mocks:
+ * century rollover, alarm 1 and 2 mask matching and the bus transactions of every driver call.
+ */
+
+#include "test.h"
+#include "i2cMock.h"
+#include "i2cBus.h"
+#include "ds3231.h"
+#include "ds3231Sim.h"
+
+/* bus transactions of one driver call */
+#define TEST_TRANSACTIONS(call, expected)	do { i2cMockReset(); call; \
+		TEST_EQUAL(i2cMockTransactions(), expected); } while(0)
+
+static void setClock(uint16_t year, uint8_t month, uint8_t date, uint8_t hour, uint8_t minute, uint8_t second)
+{
+	ds3231SetYear(year);
+	ds3231SetMonth(month);
+	ds3231SetDate(date);
+	ds3231SetHour(hour);
+	ds3231SetMin(minute);
+	ds3231SetSec(second);
+}
+
+static void testTransactions()
+{
+	TEST_TRANSACTIONS(TEST_CHECK(initds3231()), 9);
+	TEST_TRANSACTIONS(ds3231ReadTime(), 1);
+	TEST_TRANSACTIONS(ds3231ReadAllRegisters(), 1);
+	TEST_TRANSACTIONS((void)ds3231ReadTemp(), 1);
+	TEST_TRANSACTIONS(TEST_CHECK(ds3231StartConversion()), 2);
+
+	TEST_TRANSACTIONS(ds3231SetSec(0), 1);
+	TEST_TRANSACTIONS(ds3231SetHour(12), 1);
+	TEST_TRANSACTIONS(ds3231SetMonth(6), 2);
+	TEST_TRANSACTIONS(ds3231SetYear(2024), 3);
+
+	TEST_TRANSACTIONS(ds3231SetModeA1(DS3231_A1_MATCH_S_M_H), 8);
+	TEST_TRANSACTIONS(ds3231SetModeA2(DS3231_A2_MATCH_M_H), 6);
+	TEST_TRANSACTIONS(ds3231SetSecA1(30), 2);
+	TEST_TRANSACTIONS(ds3231SetDateA2(15), 2);
+
+	// a poll is one burst, the status register is only written back when an alarm flag is set
+	ds3231SetModeA1(DS3231_A1_EVERY_S);
+	ds3231SetModeA2(DS3231_A2_MATCH_M_H_DATE);
+	(void)ds3231Poll();
+	TEST_TRANSACTIONS(TEST_EQUAL(ds3231Poll(), 0), 1);
+	ds3231SimTickSecond();
+	TEST_TRANSACTIONS(TEST_EQUAL(ds3231Poll(), DS3231_EVENT_A1), 2);
+	TEST_TRANSACTIONS(TEST_CHECK(ds3231GetFlagA1()), 0);
+	TEST_TRANSACTIONS(TEST_CHECK(!ds3231GetFlagA1()), 0);
+}
+
+static void testCentury()
+{
+	setClock(2099, 12, 31, 23, 59, 59);
+	ds3231ReadTime();
+	TEST_EQUAL(current_time.year, 2099);
+	TEST_EQUAL(ds3231_sim_registers[ADDRESS_MONTH] & 0x80, 0);
+
+	ds3231SimTickSecond();
+	ds3231ReadTime();
+	TEST_EQUAL(current_time.year, 2100);
+	TEST_EQUAL(current_time.month, 1);
+	TEST_EQUAL(current_time.date, 1);
+	TEST_EQUAL(current_time.hour, 0);
+	TEST_EQUAL(current_time.minute, 0);
+	TEST_EQUAL(current_time.second, 0);
+	TEST_EQUAL(ds3231_sim_registers[ADDRESS_MONTH], 0x81);
+
+	// setting the month keeps the century
+	ds3231SetMonth(5);
+	ds3231ReadTime();
+	TEST_EQUAL(current_time.month, 5);
+	TEST_EQUAL(current_time.year, 2100);
+
+	// the bit toggles again at the end of 2199, the driver reads it as 2000
+	setClock(2199, 12, 31, 23, 59, 59);
+	ds3231ReadTime();
+	TEST_EQUAL(current_time.year, 2199);
+	ds3231SimTickSecond();
+	ds3231ReadTime();
+	TEST_EQUAL(current_time.year, 2000);
+	TEST_EQUAL(ds3231_sim_registers[ADDRESS_MONTH] & 0x80, 0);
+}
+
+/**
+ * @retval	events of a poll after one second
+ */
+static uint8_t tickAndPoll()
+{
+	ds3231SimTickSecond();
+	return ds3231Poll();
+}
+
+static void testAlarm1()
+{
+	setClock(2024, 6, 1, 12, 10, 28);
+	(void)ds3231Poll();
+
+	// seconds only: minute and hour of the alarm do not matter
+	ds3231SetModeA1(DS3231_A1_MATCH_S);
+	ds3231SetSecA1(30);
+	ds3231SetMinA1(45);
+	ds3231SetHourA1(7);
+	TEST_EQUAL(ds3231_sim_registers[ALARM1_SEC], 0x30);
+	TEST_EQUAL(ds3231_sim_registers[ALARM1_MIN], 0x80 | 0x45);	// the mask bit survives the setter
+	TEST_EQUAL(ds3231_sim_registers[ALARM1_HOUR], 0x80 | 0x07);
+	TEST_EQUAL(tickAndPoll(), 0);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+	TEST_EQUAL(tickAndPoll(), 0);
+	TEST_CHECK(ds3231GetFlagA1());
+
+	// seconds, minutes and hours: a wrong hour never matches
+	ds3231SetModeA1(DS3231_A1_MATCH_S_M_H);
+	ds3231SetMinA1(10);
+	TEST_EQUAL(ds3231_sim_registers[ALARM1_MIN], 0x10);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), 0);
+	ds3231SetHourA1(12);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+
+	// day of week instead of date
+	ds3231SetModeA1(DS3231_A1_MATCH_S_M_H_DAY);
+	ds3231SetDayA1(3);
+	ds3231SetDay(4);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), 0);
+	ds3231SetDay(3);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+
+	// date
+	ds3231SetModeA1(DS3231_A1_MATCH_S_M_H_DATE);
+	ds3231SetDateA1(1);
+	TEST_EQUAL(ds3231_sim_registers[ALARM1_DATE] & 0xc0, 0);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+	ds3231SetDate(2);
+	ds3231SetSec(29);
+	TEST_EQUAL(tickAndPoll(), 0);
+
+	// every second
+	ds3231SetModeA1(DS3231_A1_EVERY_S);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A1);
+	ds3231SetModeA1(DS3231_A1_MATCH_S_M_H_DATE);
+	ds3231SetDateA1(31);
+}
+
+static void testAlarm2()
+{
+	setClock(2024, 6, 1, 12, 10, 58);
+	(void)ds3231Poll();
+
+	// alarm 2 has no seconds, it is checked at second 00
+	ds3231SetModeA2(DS3231_A2_EVERY_M);
+	TEST_EQUAL(tickAndPoll(), 0);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A2);
+	TEST_EQUAL(tickAndPoll(), 0);
+
+	ds3231SetModeA2(DS3231_A2_MATCH_M);
+	ds3231SetMinA2(12);
+	ds3231SetHourA2(3);
+	TEST_EQUAL(ds3231_sim_registers[ALARM2_MIN], 0x12);
+	TEST_EQUAL(ds3231_sim_registers[ALARM2_HOUR], 0x80 | 0x03);
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A2);	// 12:12:00
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), 0);				// 12:13:00
+
+	ds3231SetModeA2(DS3231_A2_MATCH_M_H);
+	ds3231SetMin(11);
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), 0);				// 12:12:00, hour 3 does not match
+	ds3231SetHourA2(12);
+	ds3231SetMin(11);
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A2);
+
+	ds3231SetModeA2(DS3231_A2_MATCH_M_H_DAY);
+	ds3231SetDayA2(5);
+	ds3231SetDay(5);
+	ds3231SetMin(11);
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), DS3231_EVENT_A2);
+	ds3231SetDay(6);
+	ds3231SetMin(11);
+	ds3231SetSec(59);
+	TEST_EQUAL(tickAndPoll(), 0);
+	TEST_CHECK(ds3231GetFlagA2());
+	TEST_CHECK(!ds3231GetFlagA2());
+}
+
+int main()
+{
+	initDS3231Sim();
+	initI2CBus();
+	i2cMockReset();
+
+	testTransactions();
+	testCentury();
+	testAlarm1();
+	testAlarm2();
+
+	TEST_EQUAL(i2c_bus_stats.errors, 0);
+	TEST_EQUAL(i2c_bus_stats.recoveries, 0);
+	return testSummary("testDs3231");
+}
@@ -0,0 +1,122 @@
+/*
+ * testLatency.c
+ *
+ *  Created on: Oct 18, 2026
+ *      Author: hieun
+ *
+ * key latency samples from the button queue: buttonInject or a scan, then latencyDispatch and
+ * latencyComplete against the mocked timebase, checked in the maximum values and the histogram.
+ */
+
+#include "test.h"
+#include "button.h"
+#include "latency.h"
+#include <string.h>
+
+/**
+ * @brief	one sample: the key event is queued at edge_us, dispatched at dispatch_us and done at done_us
+ */
+static void sample(uint8_t mode, uint32_t edge_us, uint32_t dispatch_us, uint32_t done_us)
+{
+	Button_Event event;
+
+	mock_time_us = edge_us;
+	TEST_CHECK(buttonInject(5, BUTTON_PRESS));
+	mock_time_us = dispatch_us;
+	TEST_CHECK(buttonGetEvent(&event));
+	TEST_EQUAL(event.time_us, edge_us);
+	latencyDispatch(mode, &event);
+	mock_time_us = done_us;
+	latencyComplete();
+}
+
+static void testSamples()
+{
+	Latency_Stats *pStats = &latency_stats[2];
+
+	sample(2, 1000, 3000, 6000);
+	TEST_EQUAL(pStats->count, 1);
+	TEST_EQUAL(pStats->wait_max, 2000);
+	TEST_EQUAL(pStats->ui_max, 3000);
+	TEST_EQUAL(pStats->total_max, 5000);
+	TEST_EQUAL(pStats->histogram[3], 1);	// 4096 <= 5000 < 8192
+
+	sample(2, 10000, 10100, 10600);
+	TEST_EQUAL(pStats->count, 2);
+	TEST_EQUAL(pStats->wait_total, 2100);
+	TEST_EQUAL(pStats->ui_total, 3500);
+	TEST_EQUAL(pStats->total_max, 5000);
+	TEST_EQUAL(pStats->histogram[0], 1);	// 600 < 1024
+
+	// past the last bucket edge
+	sample(2, 20000, 30000, 20000 + 3000000);
+	TEST_EQUAL(pStats->total_max, 3000000);
+	TEST_EQUAL(pStats->histogram[LATENCY_HISTOGRAM_SIZE - 1], 1);
+
+	// the microsecond counter wraps between edge and done
+	sample(2, 0xffffff00, 0xffffff80, 0x00000100);
+	TEST_EQUAL(pStats->count, 4);
+	TEST_EQUAL(pStats->histogram[0], 2);	// 512
+
+	// complete without a dispatch, twice, or for a mode out of range does nothing
+	mock_time_us = 50000;
+	latencyComplete();
+	sample(3, 40000, 41000, 42000);
+	latencyComplete();
+	TEST_EQUAL(latency_stats[3].count, 1);
+	sample(KEYMAP_MODES, 40000, 41000, 42000);
+	TEST_EQUAL(pStats->count, 4);
+
+	mockRS232Clear();
+	latencyReport();
+	TEST_CHECK(strstr(mock_rs232_output, "mode 2 n:4 ") != NULL);
+	TEST_CHECK(strstr(mock_rs232_output, "total max:3000000us") != NULL);
+	TEST_CHECK(strstr(mock_rs232_output, "  <1024us: 2\r\n") != NULL);
+	TEST_CHECK(strstr(mock_rs232_output, "  <8192us: 1\r\n") != NULL);
+	TEST_CHECK(strstr(mock_rs232_output, "  >=262144us: 1\r\n") != NULL);
+	TEST_CHECK(strstr(mock_rs232_output, "mode 3 n:1 ") != NULL);
+
+	latencyReset();
+	TEST_EQUAL(pStats->count, 0);
+	TEST_EQUAL(pStats->histogram[0], 0);
+}
+
+/**
+ * @brief	a real press: the sample starts at the scan that debounced it
+ */
+static void testScan()
+{
+	Button_Event event;
+	uint32_t scans = 0;
+
+	mock_spi_input = (uint16_t)~(1 << 8);	// key 0 down
+	while(!buttonPending() && scans < 10)
+	{
+		mock_time_us = 100000 + scans * BUTTON_SCAN_MS * 1000;
+		buttonScan();
+		scans++;
+	}
+	TEST_EQUAL(scans, 4);
+	TEST_CHECK(buttonGetEvent(&event));
+	TEST_EQUAL(event.key, 0);
+	TEST_EQUAL(event.type, BUTTON_PRESS);
+
+	mock_time_us += 2500;
+	latencyDispatch(1, &event);
+	mock_time_us += 1000;
+	latencyComplete();
+	TEST_EQUAL(latency_stats[1].count, 1);
+	TEST_EQUAL(latency_stats[1].wait_max, 2500);
+	TEST_EQUAL(latency_stats[1].total_max, 3500);
+	TEST_EQUAL(latency_stats[1].histogram[2], 1);	// 2048 <= 3500 < 4096
+}
+
+int main()
+{
+	initButton();
+	initLatency();
+
+	testSamples();
+	testScan();
+	return testSummary("testLatency");
+}
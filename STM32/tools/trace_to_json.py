@@ -0,0 +1,208 @@
+#!/usr/bin/env python3
+"""
+trace_to_json.py
+
+Convert a trace dump of the firmware (UART command 't', see Core/Inc/trace.h) into
+Chrome trace event JSON, open it in chrome://tracing or https://ui.perfetto.dev
+
+    python3 trace_to_json.py capture.bin -o trace.json
+    python3 trace_to_json.py --port /dev/ttyUSB0 -o trace.json     (needs pyserial)
+
+The capture may contain other text around the dump, the last dump in it is used.
+Keep the tables below in sync with Trace_Event, Trace_Lcd and enum State.
+"""
+
+import argparse
+import json
+import re
+import struct
+import sys
+
+RECORD = struct.Struct("<IHHI")  # Trace_Record: timestamp, id, arg0, arg1
+HEADER = re.compile(rb"TRACE v(\d+) n:(\d+) lost:(\d+)\r\n")
+FOOTER = b"\r\nTRACE END\r\n"
+VERSION = 1
+
+(TRACE_RESET, TRACE_ISR_ENTER, TRACE_ISR_EXIT, TRACE_MODE,
+ TRACE_I2C_BEGIN, TRACE_I2C_END, TRACE_LCD_BEGIN, TRACE_LCD_END) = range(8)
+
+IRQ_NAMES = {28: "TIM2", 30: "TIM4", 37: "USART1"}
+LCD_NAMES = ["clear", "fill", "char", "picture", "circle"]
+MODE_NAMES = ["init", "word clock", "login", "config time", "config alarm",
+              "stopwatch", "timers", "monitor register"]
+HAL_STATUS = ["OK", "ERROR", "BUSY", "TIMEOUT"]
+
+TRACKS = {"isr": 1, "mode": 2, "i2c": 3, "lcd": 4}
+
+
+def lookup(table, index):
+    if isinstance(table, dict):
+        return table.get(index, str(index))
+    return table[index] if index < len(table) else str(index)
+
+
+def read_capture(args):
+    if args.port is None:
+        with open(args.capture, "rb") as f:
+            return f.read()
+
+    import serial  # pyserial, only needed to read the board directly
+
+    with serial.Serial(args.port, args.baud, timeout=2) as port:
+        port.reset_input_buffer()
+        port.write(b"t")
+        data = b""
+        while not data.endswith(FOOTER):
+            chunk = port.read(4096)
+            if not chunk:
+                break
+            data += chunk
+        return data
+
+
+def parse_dump(data):
+    matches = list(HEADER.finditer(data))
+    if not matches:
+        sys.exit("no trace dump found")
+    header = matches[-1]
+    version, count, lost = (int(g) for g in header.groups())
+    if version != VERSION:
+        sys.exit("trace version %d, decoder knows %d" % (version, VERSION))
+
+    start = header.end()
+    end = start + count * RECORD.size
+    if len(data) < end:
+        sys.exit("dump truncated: %d of %d records" % ((len(data) - start) // RECORD.size, count))
+    if not data[end:].startswith(FOOTER):
+        print("warning: end marker missing", file=sys.stderr)
+
+    return [RECORD.unpack_from(data, offset) for offset in range(start, end, RECORD.size)], lost
+
+
+class Timeline:
+    """build B/E pairs per track, records are in the order they were claimed on the target"""
+
+    def __init__(self):
+        self.events = []
+        self.run = 0
+        self.stacks = {}
+        self.last = None
+        self.time = 0
+        self.dropped = 0
+
+    def new_run(self):
+        self.close()
+        self.run += 1
+        self.last = None
+        self.time = 0
+        self.events.append({"ph": "M", "name": "process_name", "pid": self.run,
+                            "args": {"name": "run %d" % self.run}})
+        for name, tid in TRACKS.items():
+            self.events.append({"ph": "M", "name": "thread_name", "pid": self.run, "tid": tid,
+                                "args": {"name": name}})
+
+    def advance(self, timestamp):
+        # 32 bit microseconds wrap after 71 minutes, records are close enough to unwrap by difference
+        if self.last is not None:
+            delta = (timestamp - self.last) & 0xffffffff
+            if delta >= 0x80000000:
+                delta -= 0x100000000
+            self.time += delta
+        self.last = timestamp
+        return self.time
+
+    def begin(self, track, name, ts, args=None):
+        tid = TRACKS[track]
+        self.stacks.setdefault(tid, []).append(name)
+        event = {"ph": "B", "name": name, "pid": self.run, "tid": tid, "ts": ts}
+        if args:
+            event["args"] = args
+        self.events.append(event)
+
+    def end(self, track, ts, args=None):
+        tid = TRACKS[track]
+        stack = self.stacks.get(tid)
+        if not stack:
+            # the begin was overwritten in the ring
+            self.dropped += 1
+            return
+        event = {"ph": "E", "name": stack.pop(), "pid": self.run, "tid": tid, "ts": ts}
+        if args:
+            event["args"] = args
+        self.events.append(event)
+
+    def instant(self, track, name, ts, args=None):
+        event = {"ph": "i", "s": "t", "name": name, "pid": self.run, "tid": TRACKS[track], "ts": ts}
+        if args:
+            event["args"] = args
+        self.events.append(event)
+
+    def close(self):
+        for tid, stack in self.stacks.items():
+            while stack:
+                self.events.append({"ph": "E", "name": stack.pop(), "pid": self.run, "tid": tid,
+                                    "ts": self.time})
+        self.stacks = {}
+
+
+def convert(records):
+    timeline = Timeline()
+    timeline.new_run()
+    first = True
+
+    for timestamp, event, arg0, arg1 in records:
+        if event == TRACE_RESET:
+            if not first:
+                timeline.new_run()
+            first = False
+            timeline.advance(timestamp)
+            continue
+        first = False
+        ts = timeline.advance(timestamp)
+
+        if event == TRACE_ISR_ENTER:
+            timeline.begin("isr", lookup(IRQ_NAMES, arg0), ts)
+        elif event == TRACE_ISR_EXIT:
+            timeline.end("isr", ts)
+        elif event == TRACE_MODE:
+            timeline.end("mode", ts)
+            timeline.begin("mode", lookup(MODE_NAMES, arg1), ts, {"from": lookup(MODE_NAMES, arg0)})
+        elif event == TRACE_I2C_BEGIN:
+            device, register, size = arg1 >> 16, (arg1 >> 8) & 0xff, arg1 & 0xff
+            name = "%s 0x%02x" % ("write" if arg0 else "read", device)
+            timeline.begin("i2c", name, ts, {"register": "0x%02x" % register, "size": size})
+        elif event == TRACE_I2C_END:
+            timeline.end("i2c", ts, {"status": lookup(HAL_STATUS, arg0)})
+        elif event == TRACE_LCD_BEGIN:
+            timeline.begin("lcd", lookup(LCD_NAMES, arg0), ts, {"pixels": arg1})
+        elif event == TRACE_LCD_END:
+            timeline.end("lcd", ts)
+        else:
+            timeline.instant("isr", "unknown %d" % event, ts, {"arg0": arg0, "arg1": arg1})
+
+    timeline.close()
+    return timeline
+
+
+def main():
+    parser = argparse.ArgumentParser(description="convert a firmware trace dump to Chrome trace JSON")
+    parser.add_argument("capture", nargs="?", help="raw uart capture containing the dump")
+    parser.add_argument("--port", help="serial port, sends 't' and reads the dump")
+    parser.add_argument("--baud", type=int, default=115200)
+    parser.add_argument("-o", "--output", default="trace.json")
+    args = parser.parse_args()
+    if args.capture is None and args.port is None:
+        parser.error("give a capture file or --port")
+
+    records, lost = parse_dump(read_capture(args))
+    timeline = convert(records)
+
+    with open(args.output, "w") as f:
+        json.dump({"traceEvents": timeline.events, "displayTimeUnit": "ms"}, f)
+
+    print("%d records, %d overwritten on target, %d unmatched ends, %d runs -> %s"
+          % (len(records), lost, timeline.dropped, timeline.run, args.output))
+
+
+if __name__ == "__main__":
+    main()